@@ -0,0 +1,121 @@
+#pragma once
+
+#include <stdint.h>
+
+// Parts included by Device_Snapshot
+enum SnapshotFlags
+{
+    SNAPSHOT_PROPERTIES          = 0x1,  // property values of every component
+    SNAPSHOT_SIGNALS             = 0x2,  // signals with sample type, unit and sample rate
+    SNAPSHOT_INPUT_PORTS         = 0x4,  // input ports with the ID of the connected signal
+    SNAPSHOT_RECURSIVE           = 0x8,  // sub-devices
+    SNAPSHOT_ALL                 = 0xF
+};
+
+// daq::SampleType codes accepted by Signal_SetReadFormat
+enum SampleTypes
+{
+    SAMPLE_TYPE_NATIVE           = 0,    // the signal's own type (the raw type in raw mode)
+    SAMPLE_TYPE_FLOAT32          = 1,
+    SAMPLE_TYPE_FLOAT64          = 2,
+    SAMPLE_TYPE_UINT8            = 3,
+    SAMPLE_TYPE_INT8             = 4,
+    SAMPLE_TYPE_UINT16           = 5,
+    SAMPLE_TYPE_INT16            = 6,
+    SAMPLE_TYPE_UINT32           = 7,
+    SAMPLE_TYPE_INT32            = 8,
+    SAMPLE_TYPE_UINT64           = 9,
+    SAMPLE_TYPE_INT64            = 10,
+    SAMPLE_TYPE_RANGE_INT64      = 11,   // struct fields only, see StructField
+    SAMPLE_TYPE_COMPLEX_FLOAT32  = 12,
+    SAMPLE_TYPE_COMPLEX_FLOAT64  = 13
+};
+
+// How long a read waits, set per signal or multi reader
+enum ReadTimeoutModes
+{
+    READ_TIMEOUT_ALL             = 0,    // until every requested sample arrived or the timeout (default)
+    READ_TIMEOUT_ANY             = 1,    // until at least one sample arrived or the timeout
+    READ_TIMEOUT_NONE            = 2     // never, takes what is queued and ignores the timeout
+};
+
+// Layout of the single buffer MultiReader_ReadToBuffer writes
+enum BufferLayouts
+{
+    BUFFER_LAYOUT_INTERLEAVED    = 0,    // [sample][channel], a row per sample (row-major)
+    BUFFER_LAYOUT_PLANAR         = 1     // [channel][sample], a row per signal
+};
+
+// Compressed time axis of a linear-rule read: sample i is at t0 + i * dt until the first
+// gap, samples from a TimeBreak on continue from its t0
+typedef struct TimeAxis
+{
+    int64_t  t0;                         // time of the first sample, units of the other timestamps
+    double   dt;                         // seconds between samples
+    uint64_t count;                      // samples read
+    uint64_t discontinuities;            // gaps found, only the first maxBreaks are written out
+} TimeAxis;
+
+typedef struct TimeBreak
+{
+    uint64_t index;                      // first sample after the gap
+    int64_t  t0;                         // its time
+} TimeBreak;
+
+// Domain of a signal read in ticks: tick t is at origin + t * num / den seconds
+typedef struct TickDomain
+{
+    int64_t  origin;                     // time of tick 0, units of the other timestamps
+    int64_t  num;                        // tick resolution in seconds, num / den
+    int64_t  den;
+    int64_t  delta;                      // ticks between samples of a linear rule, 0 otherwise
+    int64_t  start;                      // first tick of a linear rule
+    char     unit[16];                   // domain unit symbol, truncated
+} TickDomain;
+
+// Result of the last read on a signal or multi reader, see ReadInfo
+enum ReadStatusCodes
+{
+    READ_STATUS_OK               = 0,
+    READ_STATUS_EVENT            = 1,    // stopped at an event packet, read again to go on
+    READ_STATUS_FAIL             = 2,
+    READ_STATUS_UNKNOWN          = 3
+};
+
+enum ReadEventFlags
+{
+    READ_EVENT_VALUE_DESCRIPTOR  = 1,    // value descriptor changed
+    READ_EVENT_DOMAIN_DESCRIPTOR = 2,    // domain descriptor changed, e.g. a new sample rate
+    READ_EVENT_OTHER             = 4,    // any other event packet, its id is in lastEvent
+    READ_EVENT_READER_REBUILT    = 8     // the reader could not convert a new descriptor and was replaced
+};
+
+typedef struct ReadInfo
+{
+    int32_t  status;                     // ReadStatusCodes of the last read
+    uint32_t events;                     // ReadEventFlags seen since the previous query
+    uint64_t eventCount;                 // event packets since the previous query
+    char     lastEvent[40];              // id of the latest of them, truncated
+} ReadInfo;
+
+// One field of the packed record layout of a struct signal
+typedef struct StructField
+{
+    char     name[48];                   // field name, nested fields as "outer.inner", truncated
+    int32_t  sampleType;                 // SampleTypes code of one element
+    uint32_t offset;                     // bytes from the start of the record
+    uint32_t size;                       // bytes of the field, elements * element size
+    uint32_t elements;                   // values of a field with dimensions, 1 otherwise
+} StructField;
+
+// Statistics of one read block; all zero when nothing was read
+typedef struct BlockStats
+{
+    uint64_t count;                      // samples in the block
+    double   mean;
+    double   rms;
+    double   min;
+    double   max;
+    double   stddev;                     // sample standard deviation (n - 1), 0 for one sample
+    double   peakToPeak;                 // max - min
+} BlockStats;
@@ -19,6 +19,21 @@ class OpenDaqObject;
 using OpenDaqObjectPtr = std::unique_ptr<OpenDaqObject>;
 using String = std::string;
 
+// Concrete wrapper type, stored next to every handle so the C ABI can check
+// what it was given without a dynamic_cast
+enum class ObjectTag : uint32_t
+{
+    Unknown = 0,
+    PropertyObject,
+    Device,
+    FunctionBlock,
+    Channel,
+    Signal,
+    InputPort,
+    Descriptor,
+    Sync
+};
+
 class OpenDaqObject
 {
 public:
@@ -46,6 +61,7 @@ public:
 
     BaseObjectPtr object = nullptr;
     BaseObjectPtr& self = object;
+    ObjectTag tag = ObjectTag::Unknown;
 };
 
 template <typename T>
@@ -53,6 +69,7 @@ auto Make_OpenDaqObjectPtr(BaseObjectPtr&& from)
 {
     OpenDaqObjectPtr ptr {new T};
     ptr->object = from;
+    ptr->tag = T::Tag;
     return ptr;
 }
 
@@ -81,6 +98,7 @@ public:
     // TODO: rewrite so that user's StdOut Pipe won't be messed with
     virtual String           get     (const string_view item)
     {
+        std::lock_guard guard(StdOutLock());
         bool piped = IsPipedToString();
         String oldbuf = GetBufferString();
         EraseBuffer();
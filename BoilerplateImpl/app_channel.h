@@ -11,6 +11,8 @@ BEGIN_NAMESPACE_OPENDAQ
 class AppChannel : public OpenDaqObjectStaticImpl<OpenDaqObject, AppChannel, ChannelPtr>
 {
 public:
+    static constexpr ObjectTag Tag = ObjectTag::Channel;
+
     static bool processCommand(OpenDaqObject& channel, const std::vector<std::string>& command);
 
     virtual ::String get(const string_view item) override
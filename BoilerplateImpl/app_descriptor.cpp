@@ -66,6 +66,7 @@ int AppDescriptor::getCount(const DataDescriptorPtr& desc, const string_view ite
 
 ::String AppDescriptor::SaveConfiguration()
 {
+    std::lock_guard guard(StdOutLock());
     bool piped = IsPipedToString();
     ::String oldbuf = GetBufferString();
     EraseBuffer();
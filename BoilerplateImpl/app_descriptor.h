@@ -11,6 +11,8 @@ BEGIN_NAMESPACE_OPENDAQ
 class AppDescriptor : public OpenDaqObjectStaticImpl<OpenDaqObject, AppDescriptor, DataDescriptorPtr>
 {
 public:
+    static constexpr ObjectTag Tag = ObjectTag::Descriptor;
+
     static bool processCommand(OpenDaqObject& channel, const std::vector<std::string>& command);
 
     virtual ::String SaveConfiguration();
@@ -7,6 +7,9 @@
 #include "app_channel.h"
 #include "app_signal.h"
 #include "app_sync.h"
+#include "component_cache.h"
+
+#include <nlohmann/json.hpp>
 
 BEGIN_NAMESPACE_OPENDAQ
 
@@ -45,8 +48,9 @@ int AppDevice::list(const DevicePtr& device, const string_view item)
     if (item == "devices")
     {
         int cnt = 0;
-        for (const auto& subDevice : device.getDevices())
+        for (const auto& child : *ComponentCache::Children(device, ChildList::Devices))
         {
+            const auto subDevice = child.asPtr<IDevice>();
             std::string name = subDevice.getInfo().getName().assigned() ? subDevice.getInfo().getName() : "";
             std::string serialNumber = subDevice.getInfo().getSerialNumber().assigned() ? subDevice.getInfo().getSerialNumber() : "";
             std::string connectionString = subDevice.getInfo().getConnectionString().assigned() ? subDevice.getInfo().getConnectionString() : "";
@@ -61,8 +65,9 @@ int AppDevice::list(const DevicePtr& device, const string_view item)
     if (item == "channels")
     {
         int cnt = 0;
-        for (const auto& channel : device.getChannels())
+        for (const auto& child : *ComponentCache::Children(device, ChildList::Channels))
         {
+            const auto channel = child.asPtr<IChannel>();
             std::string name = channel.getFunctionBlockType().getName().assigned() ? channel.getFunctionBlockType().getName() : "";
             std::string id = channel.getFunctionBlockType().getId().assigned() ? channel.getFunctionBlockType().getId() : "";
             std::cout << "[" << std::to_string(cnt) << "] Name: " << name << ", Unique ID: " << id << std::endl;
@@ -74,8 +79,9 @@ int AppDevice::list(const DevicePtr& device, const string_view item)
     if (item == "function-blocks")
     {
         int cnt = 0;
-        for (const auto& fb : device.getFunctionBlocks())
+        for (const auto& child : *ComponentCache::Children(device, ChildList::FunctionBlocks))
         {
+            const auto fb = child.asPtr<IFunctionBlock>();
             std::string name = fb.getFunctionBlockType().getName().assigned() ? fb.getFunctionBlockType().getName() : "";
             std::string id = fb.getFunctionBlockType().getId().assigned() ? fb.getFunctionBlockType().getId() : "";
             std::cout << "[" << std::to_string(cnt) << "] Name: " << name << ", Unique ID: " << id << std::endl;
@@ -87,8 +93,9 @@ int AppDevice::list(const DevicePtr& device, const string_view item)
     if (item == "signals")
     {
         int cnt = 0;
-        for (const auto& signal : device.getSignals())
+        for (const auto& child : *ComponentCache::Children(device, ChildList::Signals))
         {
+            const auto signal = child.asPtr<ISignal>();
             std::string name = signal.getDescriptor().getName().assigned() ? signal.getDescriptor().getName() : "";
             std::string id = signal.getGlobalId();
             std::cout << "[" << std::to_string(cnt) << "] Name: " << name << ", Unique ID: " << id << std::endl;
@@ -131,8 +138,9 @@ OpenDaqObjectPtr AppDevice::select(const DevicePtr& device, const string_view it
 {
     if (item == "device")
     {
-        if (index < device.getDevices().getCount())
-            return Make_OpenDaqObjectPtr<AppDevice>(device.getDevices()[index]);
+        const auto devices = ComponentCache::Children(device, ChildList::Devices);
+        if (index < devices->size())
+            return Make_OpenDaqObjectPtr<AppDevice>(BaseObjectPtr((*devices)[index]));
         else
             std::cout << "Index out of bounds." << std::endl;
         return nullptr;
@@ -140,8 +148,9 @@ OpenDaqObjectPtr AppDevice::select(const DevicePtr& device, const string_view it
 
     if (item == "function-block")
     {
-        if (index < device.getFunctionBlocks().getCount())
-            return Make_OpenDaqObjectPtr<AppFunctionBlock>(device.getFunctionBlocks()[index]);
+        const auto functionBlocks = ComponentCache::Children(device, ChildList::FunctionBlocks);
+        if (index < functionBlocks->size())
+            return Make_OpenDaqObjectPtr<AppFunctionBlock>(BaseObjectPtr((*functionBlocks)[index]));
         else
             std::cout << "Index out of bounds." << std::endl;
         return nullptr;
@@ -149,8 +158,9 @@ OpenDaqObjectPtr AppDevice::select(const DevicePtr& device, const string_view it
 
     if (item == "channel")
     {
-        if (index < device.getChannels().getCount())
-            return Make_OpenDaqObjectPtr<AppChannel>(device.getChannels()[index]);
+        const auto channels = ComponentCache::Children(device, ChildList::Channels);
+        if (index < channels->size())
+            return Make_OpenDaqObjectPtr<AppChannel>(BaseObjectPtr((*channels)[index]));
         else
             std::cout << "Index out of bounds." << std::endl;
         return nullptr;
@@ -158,8 +168,9 @@ OpenDaqObjectPtr AppDevice::select(const DevicePtr& device, const string_view it
 
     if (item == "signal")
     {
-        if (device.getSignals().getCount() > index)
-            return Make_OpenDaqObjectPtr<AppSignal>(device.getSignals()[index]);
+        const auto signals = ComponentCache::Children(device, ChildList::Signals);
+        if (index < signals->size())
+            return Make_OpenDaqObjectPtr<AppSignal>(BaseObjectPtr((*signals)[index]));
         else
             std::cout << "Index out of bounds." << std::endl;
         return nullptr;
@@ -210,18 +221,22 @@ int AppDevice::remove(const DevicePtr& device, const string_view item, uint64_t
     if (item == "device")
     {
         if (index < device.getDevices().getCount())
+        {
             device.removeDevice(device.getDevices()[index]);
-        else
-            std::cout << "Index out of bounds." << std::endl;
+            return EC_OK;
+        }
+        std::cout << "Index out of bounds." << std::endl;
         return EC_ARRAY_OUT_OF_BOUNDS;
     }
     
     if (item == "function-block")
     {
         if (index < device.getFunctionBlocks().getCount())
+        {
             device.removeFunctionBlock(device.getFunctionBlocks()[index]);
-        else
-            std::cout << "Index out of bounds." << std::endl;
+            return EC_OK;
+        }
+        std::cout << "Index out of bounds." << std::endl;
         return EC_ARRAY_OUT_OF_BOUNDS;
     }
 
@@ -335,19 +350,206 @@ int AppDevice::LoadConfiguration(const char* json)
     return str.toStdString();
 }
 
+static nlohmann::json PropertiesToJson(const PropertyObjectPtr& object)
+{
+    auto json = nlohmann::json::object();
+
+    for (const auto& prop : object.getVisibleProperties())
+    {
+        const std::string name = prop.getName();
+
+        switch (prop.getValueType())
+        {
+            case ctBool:
+            {
+                bool value = false;
+                if (AppPropertyObject::getValue(object, name, value) == EC_OK)
+                    json[name] = value;
+                break;
+            }
+            case ctInt:
+            {
+                int64_t value = 0;
+                if (AppPropertyObject::getValue(object, name, value) == EC_OK)
+                    json[name] = value;
+                break;
+            }
+            case ctFloat:
+            {
+                double value = 0;
+                if (AppPropertyObject::getValue(object, name, value) == EC_OK)
+                    json[name] = value;
+                break;
+            }
+            default:
+            {
+                ::String value;
+                if (AppPropertyObject::getValue(object, name, value) == EC_OK)
+                    json[name] = value;
+            }
+        }
+    }
+    return json;
+}
+
+static std::string NameOf(const ComponentPtr& component)
+{
+    return component.getName().assigned() ? component.getName().toStdString() : "";
+}
+
+// Samples per second of a signal whose domain follows a linear rule, 0 when it does not
+static double SampleRateOf(const SignalPtr& signal)
+{
+    const auto domain = signal.getDomainSignal();
+    if (!domain.assigned() || !domain.getDescriptor().assigned())
+        return 0;
+
+    const auto descriptor = domain.getDescriptor();
+    const auto rule = descriptor.getRule();
+    const auto resolution = descriptor.getTickResolution();
+    if (!rule.assigned() || rule.getType() != DataRuleType::Linear || !resolution.assigned())
+        return 0;
+
+    const Int delta = rule.getParameters().get("delta");
+    if (delta == 0 || resolution.getNumerator() == 0)
+        return 0;
+
+    return static_cast<double>(resolution.getDenominator()) / (static_cast<double>(resolution.getNumerator()) * delta);
+}
+
+static nlohmann::json SignalToJson(const SignalPtr& signal, uint32_t flags)
+{
+    nlohmann::json json = {
+        {"id", signal.getGlobalId().toStdString()},
+        {"name", NameOf(signal)},
+        {"active", static_cast<bool>(signal.getActive())}
+    };
+
+    const auto descriptor = signal.getDescriptor();
+    if (descriptor.assigned())
+    {
+        json["sampleType"] = static_cast<int>(descriptor.getSampleType());
+        if (descriptor.getUnit().assigned() && descriptor.getUnit().getSymbol().assigned())
+            json["unit"] = descriptor.getUnit().getSymbol().toStdString();
+    }
+
+    const auto domain = signal.getDomainSignal();
+    if (domain.assigned())
+    {
+        json["domainSignalId"] = domain.getGlobalId().toStdString();
+        json["sampleRate"] = SampleRateOf(signal);
+    }
+
+    if (flags & SNAPSHOT_PROPERTIES)
+        json["properties"] = PropertiesToJson(signal);
+
+    return json;
+}
+
+static nlohmann::json FunctionBlockToJson(const FunctionBlockPtr& fb, uint32_t flags)
+{
+    nlohmann::json json = {
+        {"id", fb.getGlobalId().toStdString()},
+        {"name", NameOf(fb)}
+    };
+
+    const auto type = fb.getFunctionBlockType();
+    if (type.assigned() && type.getId().assigned())
+        json["typeId"] = type.getId().toStdString();
+
+    if (flags & SNAPSHOT_PROPERTIES)
+        json["properties"] = PropertiesToJson(fb);
+
+    if (flags & SNAPSHOT_SIGNALS)
+    {
+        auto& signals = json["signals"] = nlohmann::json::array();
+        for (const auto& signal : fb.getSignals())
+            signals.push_back(SignalToJson(signal, flags));
+    }
+
+    if (flags & SNAPSHOT_INPUT_PORTS)
+    {
+        auto& ports = json["inputPorts"] = nlohmann::json::array();
+        for (const auto& port : fb.getInputPorts())
+        {
+            const auto signal = port.getSignal();
+            ports.push_back({
+                {"id", port.getGlobalId().toStdString()},
+                {"name", NameOf(port)},
+                {"signalId", signal.assigned() ? nlohmann::json(signal.getGlobalId().toStdString()) : nlohmann::json()}
+            });
+        }
+    }
+
+    auto& children = json["functionBlocks"] = nlohmann::json::array();
+    for (const auto& child : fb.getFunctionBlocks())
+        children.push_back(FunctionBlockToJson(child, flags));
+
+    return json;
+}
+
+static nlohmann::json DeviceToJson(const DevicePtr& device, uint32_t flags)
+{
+    nlohmann::json json = {
+        {"id", device.getGlobalId().toStdString()},
+        {"name", NameOf(device)}
+    };
+
+    const auto info = device.getInfo();
+    if (info.assigned())
+    {
+        if (info.getConnectionString().assigned())
+            json["connectionString"] = info.getConnectionString().toStdString();
+        if (info.getSerialNumber().assigned())
+            json["serialNumber"] = info.getSerialNumber().toStdString();
+    }
+
+    if (flags & SNAPSHOT_PROPERTIES)
+        json["properties"] = PropertiesToJson(device);
+
+    if (flags & SNAPSHOT_SIGNALS)
+    {
+        auto& signals = json["signals"] = nlohmann::json::array();
+        for (const auto& child : *ComponentCache::Children(device, ChildList::Signals))
+            signals.push_back(SignalToJson(child.asPtr<ISignal>(), flags));
+    }
+
+    auto& channels = json["channels"] = nlohmann::json::array();
+    for (const auto& child : *ComponentCache::Children(device, ChildList::Channels))
+        channels.push_back(FunctionBlockToJson(child.asPtr<IFunctionBlock>(), flags));
+
+    auto& functionBlocks = json["functionBlocks"] = nlohmann::json::array();
+    for (const auto& child : *ComponentCache::Children(device, ChildList::FunctionBlocks))
+        functionBlocks.push_back(FunctionBlockToJson(child.asPtr<IFunctionBlock>(), flags));
+
+    if (flags & SNAPSHOT_RECURSIVE)
+    {
+        auto& devices = json["devices"] = nlohmann::json::array();
+        for (const auto& child : *ComponentCache::Children(device, ChildList::Devices))
+            devices.push_back(DeviceToJson(child.asPtr<IDevice>(), flags));
+    }
+
+    return json;
+}
+
+::String AppDevice::Snapshot(uint32_t flags)
+{
+    return DeviceToJson(this->object, flags).dump();
+}
+
 int AppDevice::getCount(const DevicePtr& device, const string_view item)
 {
     if (item == "devices")
-        return device.getDevices().getCount();
+        return ComponentCache::Children(device, ChildList::Devices)->size();
 
     if (item == "function-blocks")
-        return device.getFunctionBlocks().getCount();
+        return ComponentCache::Children(device, ChildList::FunctionBlocks)->size();
 
     if (item == "channels")
-        return device.getChannels().getCount();
+        return ComponentCache::Children(device, ChildList::Channels)->size();
 
     if (item == "signals")
-        return device.getSignals().getCount();;
+        return ComponentCache::Children(device, ChildList::Signals)->size();
 
     if (item == "available-devices")
         return device.getAvailableDevices().getCount();
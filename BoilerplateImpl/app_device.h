@@ -6,12 +6,15 @@
 
 #include "OpenDaqObject.h"
 #include "../ErrorCodes.h"
+#include "../AbiTypes.h"
 
 BEGIN_NAMESPACE_OPENDAQ
 
 class AppDevice : public OpenDaqObjectStaticImpl<OpenDaqObject, AppDevice, DevicePtr>
 {
 public:
+    static constexpr ObjectTag Tag = ObjectTag::Device;
+
     static bool processCommand(OpenDaqObject& device, const std::vector<std::string>& command);
 
     virtual OpenDaqObjectPtr Add(const string_view type, const string_view what);
@@ -19,6 +22,8 @@ public:
 
     virtual int LoadConfiguration(const char* json);
     virtual ::String SaveConfiguration();
+    // Whole subtree as compact JSON, the SnapshotFlags in AbiTypes.h pick what is included
+    virtual ::String Snapshot(uint32_t flags);
 
     virtual ::String GetAvailableDeviceConnectionString(uint64_t index);
     virtual ::String GetAvailableFunctionBlockID(uint64_t index);
@@ -90,7 +90,7 @@ OpenDaqObjectPtr AppFunctionBlock::select(const FunctionBlockPtr& fb, const stri
     if (item == "input-port")
     {
         if (fbPtr.getInputPorts().getCount() > index) {
-            return Make_OpenDaqObjectPtr<AppInputPort>(fbPtr.getSignals()[index]);
+            return Make_OpenDaqObjectPtr<AppInputPort>(fbPtr.getInputPorts()[index]);
         }
         else
             std::cout << "Index out of bounds." << std::endl;
@@ -14,6 +14,8 @@ class AppChannel;
 class AppFunctionBlock : public OpenDaqObjectStaticImpl<OpenDaqObject, AppFunctionBlock, FunctionBlockPtr>
 {
 public:
+    static constexpr ObjectTag Tag = ObjectTag::FunctionBlock;
+
     static bool processCommand(OpenDaqObject& obj, const std::vector<std::string>& command);
 
     virtual ::String get(const string_view item) override
@@ -6,6 +6,7 @@
 
 #include "app_signal.h"
 #include "app_property_object.h"
+#include "component_cache.h"
 
 BEGIN_NAMESPACE_OPENDAQ
 
@@ -33,13 +34,11 @@ bool AppInputPort::processCommand(OpenDaqObject& output, const std::vector<std::
 
 int AppInputPort::connect(const InputPortPtr& port, const string_view signalId, const InstancePtr& instance)
 {
-    for (auto signal : instance.getSignalsRecursive())
+    const auto signal = ComponentCache::FindSignal(instance, signalId);
+    if (signal.assigned())
     {
-        if (signal.getGlobalId().toStdString() == signalId)
-        {
-            port.connect(signal);
-            return EC_OK;
-        }
+        port.connect(signal);
+        return EC_OK;
     }
 
     std::cout << "Invalid signal ID." << std::endl;
@@ -139,6 +138,11 @@ int AppInputPort::connect(const string_view signalId, const InstancePtr& instanc
 {
     return connect(this->object, signalId, instance);
 }
+int AppInputPort::connect(const SignalPtr& signal)
+{
+    this->object.asPtr<IInputPort>().connect(signal);
+    return EC_OK;
+}
 int AppInputPort::disconnect()
 {
     return disconnect(this->object);
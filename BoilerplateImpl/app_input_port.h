@@ -1,6 +1,7 @@
 #pragma once
 #include <opendaq/input_port_ptr.h>
 #include <opendaq/instance_ptr.h>
+#include <opendaq/signal_ptr.h>
 
 #include <iostream>
 
@@ -12,6 +13,8 @@ BEGIN_NAMESPACE_OPENDAQ
 class AppInputPort : public OpenDaqObjectStaticImpl<OpenDaqObject, AppInputPort, InputPortPtr>
 {
 public:
+    static constexpr ObjectTag Tag = ObjectTag::InputPort;
+
     static bool processCommand(OpenDaqObject& port, const std::vector<std::string>& command, const InstancePtr& instance);
 
     AppInputPort() = default;
@@ -21,6 +24,7 @@ public:
     }
 
     virtual int connect(const string_view signalId, const InstancePtr& instance);
+    virtual int connect(const SignalPtr& signal);
     virtual int disconnect();
 
 private:
@@ -2,6 +2,8 @@
 #include <coreobjects/eval_value_factory.h>
 #include <iostream>
 #include <iomanip>
+#include <charconv>
+#include <cmath>
 
 BEGIN_NAMESPACE_OPENDAQ
 
@@ -26,27 +28,187 @@ bool AppPropertyObject::processCommand(OpenDaqObject& propObj, const std::vector
 int AppPropertyObject::set(const PropertyObjectPtr& prop, const string_view item, const string_view value)
 {
     auto itemPtr = daq::String(item.data(), item.size());
-    auto valuePtr = daq::String(value.data(), value.size());
     if (!prop.hasProperty(itemPtr))
     {
         std::cout << "Property not available." << std::endl;
         return EC_PROPERTY_DOESNT_EXIST;
     }
 
+    int result = setText(prop, itemPtr, value);
+    if (result != EC_OK)
+        std::cout << "Failed to set property value." << std::endl;
+
+    return result;
+}
+
+// Plain numbers and booleans are parsed directly, anything else falls back to EvalValue
+BaseObjectPtr AppPropertyObject::parseValue(CoreType type, const string_view value)
+{
+    const auto first = value.data();
+    const auto last = value.data() + value.size();
+
+    if (type == ctInt)
+    {
+        Int parsed{};
+        auto [end, err] = std::from_chars(first, last, parsed);
+        if (err == std::errc() && end == last)
+            return Integer(parsed);
+    }
+    else if (type == ctFloat)
+    {
+        Float parsed{};
+        auto [end, err] = std::from_chars(first, last, parsed);
+        if (err == std::errc() && end == last)
+            return Floating(parsed);
+    }
+    else if (type == ctBool)
+    {
+        if (value == "true" || value == "True" || value == "1")
+            return Boolean(true);
+        if (value == "false" || value == "False" || value == "0")
+            return Boolean(false);
+    }
+
+    const auto eval = EvalValue(daq::String(value.data(), value.size()));
+    return eval.getResult();
+}
+
+// anything but a missing or read-only property means the value did not fit the value type
+static int errorOf(const DaqException& e)
+{
+    switch (e.getErrCode())
+    {
+        case OPENDAQ_ERR_NOTFOUND:
+            return EC_PROPERTY_DOESNT_EXIST;
+        case OPENDAQ_ERR_ACCESSDENIED:
+            return EC_PROPERTY_READ_ONLY;
+        default:
+            return EC_CONVERSION_FAILED;
+    }
+}
+
+int AppPropertyObject::setText(const PropertyObjectPtr& prop, const StringPtr& item, const string_view value)
+{
     try
     {
-        const auto eval = EvalValue(valuePtr);
-        const BaseObjectPtr evaluated = eval.getResult();
-        prop.setPropertyValue(itemPtr, evaluated);
+        const auto type = prop.getProperty(item).getValueType();
+        prop.setPropertyValue(item, parseValue(type, value));
         return EC_OK;
     }
+    catch (const DaqException& e)
+    {
+        return errorOf(e);
+    }
     catch (...)
     {
-        std::cout << "Failed to set property value." << std::endl;
-        return EC_PROPERTY_DOESNT_EXIST;
+        return EC_GENERIC_ERROR;
+    }
+}
+
+// a double only becomes an integer when it is finite, whole and inside the int64 range;
+// static_cast would be undefined for the rest and silently truncate fractions
+static bool toInteger(double value, Int& out)
+{
+    if (!std::isfinite(value) || std::trunc(value) != value)
+        return false;
+    if (value < -9223372036854775808.0 || value >= 9223372036854775808.0)
+        return false;
+    out = static_cast<Int>(value);
+    return true;
+}
+
+static bool toInteger(int64_t value, Int& out)
+{
+    out = value;
+    return true;
+}
+
+static bool toInteger(bool value, Int& out)
+{
+    out = value ? 1 : 0;
+    return true;
+}
+
+template <typename T>
+static int setConverted(const PropertyObjectPtr& prop, const string_view item, T value)
+{
+    try
+    {
+        auto itemPtr = daq::String(item.data(), item.size());
+        if (!prop.hasProperty(itemPtr))
+            return EC_PROPERTY_DOESNT_EXIST;
+
+        switch (prop.getProperty(itemPtr).getValueType())
+        {
+            case ctFloat:
+                prop.setPropertyValue(itemPtr, Floating(static_cast<Float>(value)));
+                return EC_OK;
+            case ctInt:
+            {
+                Int integer = 0;
+                if (!toInteger(value, integer))
+                    return EC_CONVERSION_FAILED;
+                prop.setPropertyValue(itemPtr, Integer(integer));
+                return EC_OK;
+            }
+            case ctBool:
+                prop.setPropertyValue(itemPtr, Boolean(value != T{}));
+                return EC_OK;
+            default: ;
+        }
+        return EC_OBJECT_TYPE_MISMATCH;
+    }
+    catch (const DaqException& e)
+    {
+        return errorOf(e);
+    }
+    catch (...)
+    {
+        return EC_GENERIC_ERROR;
     }
 }
 
+int AppPropertyObject::setValue(const PropertyObjectPtr& prop, const string_view item, double value)
+{
+    return setConverted(prop, item, value);
+}
+
+int AppPropertyObject::setValue(const PropertyObjectPtr& prop, const string_view item, int64_t value)
+{
+    return setConverted(prop, item, value);
+}
+
+int AppPropertyObject::setValue(const PropertyObjectPtr& prop, const string_view item, bool value)
+{
+    return setConverted(prop, item, value);
+}
+
+int AppPropertyObject::setMany(const PropertyObjectPtr& prop, const char* const* items, const char* const* values, size_t count)
+{
+    int result = EC_OK;
+
+    prop.beginUpdate();
+    try
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto itemPtr = daq::String(items[i]);
+            int error = prop.hasProperty(itemPtr) ? setText(prop, itemPtr, values[i]) : EC_PROPERTY_DOESNT_EXIST;
+
+            if (result == EC_OK)
+                result = error;
+        }
+    }
+    catch (...)
+    {
+        prop.endUpdate();
+        throw;
+    }
+    prop.endUpdate();
+
+    return result;
+}
+
 int AppPropertyObject::print(const PropertyObjectPtr& prop, const string_view item)
 {
     auto str = get(prop, item);
@@ -78,6 +240,60 @@ int AppPropertyObject::print(const PropertyObjectPtr& prop, const string_view it
     return nullptr;
 }
 
+template <typename T, typename Convert>
+static int getConverted(const PropertyObjectPtr& prop, const string_view item, T& out, Convert convert)
+{
+    auto itemPtr = daq::String(item.data(), item.size());
+    if (!prop.hasProperty(itemPtr))
+        return EC_PROPERTY_DOESNT_EXIST;
+
+    const auto convertible = prop.getPropertyValue(itemPtr).asPtrOrNull<IConvertible>();
+    if (!convertible.assigned())
+        return EC_OBJECT_TYPE_MISMATCH;
+
+    return OPENDAQ_SUCCEEDED(convert(convertible, out)) ? EC_OK : EC_OBJECT_TYPE_MISMATCH;
+}
+
+int AppPropertyObject::getValue(const PropertyObjectPtr& prop, const string_view item, double& out)
+{
+    return getConverted(prop, item, out, [](const auto& value, double& result) {
+        Float converted{};
+        auto err = value->toFloat(&converted);
+        result = converted;
+        return err;
+    });
+}
+
+int AppPropertyObject::getValue(const PropertyObjectPtr& prop, const string_view item, int64_t& out)
+{
+    return getConverted(prop, item, out, [](const auto& value, int64_t& result) {
+        Int converted{};
+        auto err = value->toInt(&converted);
+        result = converted;
+        return err;
+    });
+}
+
+int AppPropertyObject::getValue(const PropertyObjectPtr& prop, const string_view item, bool& out)
+{
+    return getConverted(prop, item, out, [](const auto& value, bool& result) {
+        Bool converted{};
+        auto err = value->toBool(&converted);
+        result = converted;
+        return err;
+    });
+}
+
+int AppPropertyObject::getValue(const PropertyObjectPtr& prop, const string_view item, ::String& out)
+{
+    auto itemPtr = daq::String(item.data(), item.size());
+    if (!prop.hasProperty(itemPtr))
+        return EC_PROPERTY_DOESNT_EXIST;
+
+    out = prop.getPropertyValue(itemPtr).toString().toStdString();
+    return EC_OK;
+}
+
 int AppPropertyObject::list(const PropertyObjectPtr& propObj, const string_view item)
 {
     if (item != "properties")
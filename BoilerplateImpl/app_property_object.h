@@ -20,6 +20,8 @@ class AppInputPort;
 class AppPropertyObject : public OpenDaqObjectStaticImpl<OpenDaqObject, AppPropertyObject, PropertyObjectPtr>
 {
 public:
+    static constexpr ObjectTag Tag = ObjectTag::PropertyObject;
+
     static bool processCommand(OpenDaqObject& propObj, const std::vector<std::string>& command);
 
     virtual ::String get(const string_view item) override
@@ -27,6 +29,21 @@ public:
         return AppPropertyObject::get(this->object, item);
     }
 
+    // Typed reads straight from getPropertyValue. Unlike get() these never print or touch std::cout
+    static int      getValue(const PropertyObjectPtr& prop, const string_view item, double& out);
+    static int      getValue(const PropertyObjectPtr& prop, const string_view item, int64_t& out);
+    static int      getValue(const PropertyObjectPtr& prop, const string_view item, bool& out);
+    static int      getValue(const PropertyObjectPtr& prop, const string_view item, ::String& out);
+
+    // Typed writes, converted to the property's own value type without going through EvalValue
+    static int      setValue(const PropertyObjectPtr& prop, const string_view item, double value);
+    static int      setValue(const PropertyObjectPtr& prop, const string_view item, int64_t value);
+    static int      setValue(const PropertyObjectPtr& prop, const string_view item, bool value);
+
+    // Applies all values inside one beginUpdate/endUpdate transaction. Returns the first error
+    // (EC_CONVERSION_FAILED, EC_PROPERTY_READ_ONLY, ...), the remaining values are still applied
+    static int      setMany (const PropertyObjectPtr& prop, const char* const* items, const char* const* values, size_t count);
+
 private:
     static int      print   (const PropertyObjectPtr& prop, const string_view item);
     static int      list    (const PropertyObjectPtr& prop, const string_view item);
@@ -50,6 +67,9 @@ private:
         return EC_PROPERTY_DOESNT_EXIST;
     }
 
+    static int      setText (const PropertyObjectPtr& prop, const StringPtr& item, const string_view value);
+    static BaseObjectPtr parseValue(CoreType type, const string_view value);
+
     static void printSingleInfo(const std::string& type, const std::string& info);
     static void printProperty(const PropertyPtr& info);
     static std::string coreTypeToString(CoreType type);
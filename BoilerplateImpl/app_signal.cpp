@@ -1,20 +1,33 @@
 #include "app_signal.h"
+#include <algorithm>
 #include <opendaq/sample_type_traits.h>
 #include <iomanip>
 #include <iostream>
 #include <charconv>
 #include <chrono>
+#include <system_error>
 #include <thread>
 #include <unordered_set>
+#include <limits>
 
 #include "opendaq/opendaq.h"
 
 #include "app_property_object.h"
 #include "app_descriptor.h"
+#include "sample_kernels.h"
 
 #include <nlohmann/json.hpp>
 
-BoundMultiReader::BoundMultiReader(const daq::ListPtr<daq::SignalPtr>& from, void** signal_ptrs) :
+static daq::MultiReaderPtr MakeMultiReader(const daq::ListPtr<daq::SignalPtr>& from, daq::SampleType valueType,
+                                           daq::ReadMode mode, daq::ReadTimeoutType timeoutType)
+{
+    return daq::MultiReader(
+        from, valueType,
+        daq::SampleType::Int64, mode,
+        timeoutType);
+}
+
+BoundMultiReader::BoundMultiReader(const daq::ListPtr<daq::SignalPtr>& from, void** signal_ptrs, bool ticks) :
     signals(
         signal_ptrs,
         signal_ptrs + from.getCount()
@@ -23,16 +36,21 @@ BoundMultiReader::BoundMultiReader(const daq::ListPtr<daq::SignalPtr>& from, voi
         from
     ),
     multireader(
-        daq::MultiReader(
-            from, daq::SampleType::Float64,
-            daq::SampleType::Int64, daq::ReadMode::Scaled,
-            daq::ReadTimeoutType::All)
+        MakeMultiReader(from, daq::SampleType::Float64, daq::ReadMode::Scaled, daq::ReadTimeoutType::All)
+    ),
+    domain(
+        daq::DomainInfo::FromSignal(from[0])
     ),
-    timereader(
-        daq::TimeReader(this->multireader)
+    timeScratch(
+        from.getCount()
+    ),
+    valueScratch(
+        from.getCount()
     )
 {
-    return;
+    // built in place, a TimeReader keeps a reference to the reader it wraps
+    if(!ticks)
+        timereader.emplace(multireader);
 }
 
 
@@ -339,28 +357,33 @@ void AppSignal::printDimensions(const ListPtr<IDimension>& dimensions, std::stre
     auto count = 0u;
     for (auto it = dimensions.begin(); it != dimensions.end(); ++it, ++count)
     {
-        std::cout << std::setw(indent * (indentLevel + 1)) << "" << "{";
+        std::cout << std::setw(indent * (indentLevel + 1)) << "" << "{" << std::endl;
+
+        // every member is optional, so the comma goes in front of all but the first
+        const char* separator = "";
 
         std::string name = (*it).getName().assigned() ? (*it).getName() : "";
         if (!name.empty())
         {
             std::cout << std::setw(indent * (indentLevel + 2)) << ""
-                      << "\"name\": \"" << name << "\",";
+                      << "\"name\": \"" << name << "\"";
+            separator = ",\n";
         }
 
         if ((*it).getUnit().assigned())
         {
+            std::cout << separator;
             printUnit((*it).getUnit(), indent, indentLevel + 2);
-            std::cout << "," << std::endl;
+            separator = ",\n";
         }
 
         if ((*it).getRule().assigned())
         {
+            std::cout << separator;
             printDimensionRule((*it).getRule(), indent, indentLevel + 2);
-            std::cout << std::endl;
         }
 
-        std::cout << std::setw(indent * (indentLevel + 1)) << "" << "}";
+        std::cout << std::endl << std::setw(indent * (indentLevel + 1)) << "" << "}";
         if (count < len - 1)
             std::cout << ",";
         std::cout << std::endl;
@@ -563,37 +586,932 @@ void AppSignal::SendTestDataPacket(const SignalConfigPtr& signal, size_t count,
     signal.sendPacket(packet);
 }
 
+static_assert(static_cast<int>(SampleType::Float32) == SAMPLE_TYPE_FLOAT32 &&
+              static_cast<int>(SampleType::Int64)   == SAMPLE_TYPE_INT64,
+              "SampleTypes in AbiTypes.h have to match daq::SampleType");
+static_assert(static_cast<int>(ReadStatus::Ok)      == READ_STATUS_OK &&
+              static_cast<int>(ReadStatus::Event)   == READ_STATUS_EVENT &&
+              static_cast<int>(ReadStatus::Unknown) == READ_STATUS_UNKNOWN,
+              "ReadStatusCodes in AbiTypes.h have to match daq::ReadStatus");
+
+void AppSignal::prepareReader(const ReadFormat& format)
+{
+    if(reader != nullptr && format == readerFormat)
+        return;
+
+    reader = StreamReader(this->object.asPtr<ISignal>(), format.valueType, SampleType::Int64,
+                          format.mode, timeoutType);
+    readerFormat = format;
+    domain = DomainInfo::FromSignal(this->object.asPtr<ISignal>());
+
+    if(dataCallback.fn)
+        InstallDataCallback(reader, dataCallback.fn, dataCallback.user, dataCallback.minSamples);
+}
+
+// Reader statuses only carry the event packet, sort it into ReadEventFlags and keep its id
+static uint32_t EventFlagsOf(const EventPacketPtr& packet, ReadInfo& info)
+{
+    if(!packet.assigned())
+        return 0;
+
+    const std::string id = packet.getEventId();
+    const auto length = std::min(id.size(), sizeof(info.lastEvent) - 1);
+    memcpy(info.lastEvent, id.data(), length);
+    info.lastEvent[length] = '\0';
+    ++info.eventCount;
+
+    if(id != event_packet_id::DATA_DESCRIPTOR_CHANGED)
+        return READ_EVENT_OTHER;
+
+    const auto params = packet.getParameters();
+    const auto changed = [&params](const char* name)
+    {
+        return params.hasKey(name) && params.get(name).assigned();
+    };
+
+    uint32_t flags = 0;
+    if(changed(event_packet_param::DATA_DESCRIPTOR))
+        flags |= READ_EVENT_VALUE_DESCRIPTOR;
+    if(changed(event_packet_param::DOMAIN_DATA_DESCRIPTOR))
+        flags |= READ_EVENT_DOMAIN_DESCRIPTOR;
+
+    return flags;
+}
+
+void AppSignal::noteStatus(const ReaderStatusPtr& status)
+{
+    if(!status.assigned())
+        return;
+
+    lastRead.status = static_cast<int32_t>(status.getReadStatus());
+
+    if(status.getReadStatus() == ReadStatus::Event) {
+        const uint32_t flags = EventFlagsOf(status.getEventPacket(), lastRead);
+        lastRead.events |= flags;
+
+        // tick conversions work from the cached domain
+        if(flags & READ_EVENT_DOMAIN_DESCRIPTOR)
+            domain = DomainInfo::FromSignal(this->object.asPtr<ISignal>());
+    }
+
+    if(!status.getValid()) {
+        rebuildReader();
+        lastRead.events |= READ_EVENT_READER_REBUILT;
+    }
+}
+
+void AppSignal::rebuildReader()
+{
+    reader.setOnDataAvailable(nullptr);
+
+    // continues where the invalidated reader stopped, with the same mode and timeout type
+    reader = StreamReaderFromExisting(reader, readerFormat.valueType, SampleType::Int64);
+
+    if(dataCallback.fn)
+        InstallDataCallback(reader, dataCallback.fn, dataCallback.user, dataCallback.minSamples);
+}
+
+int AppSignal::GetReadInfo(ReadInfo& info)
+{
+    std::lock_guard guard(samplesLock);
+
+    TakeReadInfo(lastRead, info);
+    return EC_OK;
+}
+
+void AppSignal::readTimed(void* values, int64_t* timestamps, SizeT& count, int timeout, ReaderStatusPtr& status)
+{
+    if(!timestamps) {
+        reader.read(values, &count, readTimeout(timeout), &status);
+        return;
+    }
+
+    reader.readWithDomain(values, timestamps, &count, readTimeout(timeout), &status);
+
+    // without a tick resolution there is no time to convert to, the ticks are handed out
+    for(SizeT i = 0; domain.valid && i < count; ++i)
+        timestamps[i] = domain.toClock(timestamps[i]);
+}
+
+// Walks the domain of one read and records every sample whose distance to the previous one
+// is off the nominal step by more than tolerance. toClock converts a domain value for the caller
+template <typename ToClock>
+static void CompressTimeAxis(const int64_t* domain, size_t count, int64_t step, int64_t tolerance,
+                             double dt, ToClock&& toClock, TimeAxis& axis, TimeBreak* breaks, size_t maxBreaks)
+{
+    axis.t0 = count ? toClock(domain[0]) : 0;
+    axis.dt = dt;
+    axis.count = count;
+    axis.discontinuities = 0;
+
+    for(size_t i = 1; i < count; ++i) {
+        const int64_t offStep = domain[i] - domain[i - 1] - step;
+        if(offStep > tolerance || offStep < -tolerance) {
+            if(axis.discontinuities < maxBreaks)
+                breaks[axis.discontinuities] = { i, toClock(domain[i]) };
+            ++axis.discontinuities;
+        }
+    }
+}
+
 int AppSignal::Read(uint64_t NumOfSamples, int timeout)
 {
-    auto signal = this->object.asPtr<ISignal>();
+    std::lock_guard guard(samplesLock);
 
     //SendTestData(signal, NumOfSamples);
 
-    if(reader == nullptr)
-        reader = StreamReader(signal, ReadTimeoutType::All);
-
-    auto timeReader = TimeReader(reader);
+    prepareReader({});
 
     samples.Resize(NumOfSamples);
 
-    auto status = ReaderStatus();
+    ReaderStatusPtr status;
+    SizeT readCount = NumOfSamples;
 
-    timeReader.readWithDomain(
+    readTimed(
         samples.readings.data(),
-        samples.timestamps.data(),
-        &samples.readCount,
+        reinterpret_cast<int64_t*>(samples.timestamps.data()),
+        readCount,
         timeout,
-        &status
+        status
     );
+    samples.readCount = readCount;
 
-    [[maybe_unused]]
-    daq::ReadStatus whu_happen = status.getReadStatus();
-
-    //std::cout << (int)whu_happen << std::endl;
+    noteStatus(status);
 
     return samples.readCount;
 }
 
+int AppSignal::ReadInto(double* values, int64_t* timestamps, size_t count, int timeout)
+{
+    std::lock_guard guard(samplesLock);
+    ReaderStatusPtr status;
+
+    prepareReader({});
+    SizeT readCount = count;
+
+    readTimed(values, timestamps, readCount, timeout, status);
+
+    noteStatus(status);
+
+    return static_cast<int>(readCount);
+}
+
+int AppSignal::ReadTicksInto(double* values, int64_t* ticks, size_t count, int timeout)
+{
+    std::lock_guard guard(samplesLock);
+    ReaderStatusPtr status;
+
+    prepareReader({});
+    SizeT readCount = count;
+
+    if(ticks)
+        reader.readWithDomain(values, ticks, &readCount, readTimeout(timeout), &status);
+    else
+        reader.read(values, &readCount, readTimeout(timeout), &status);
+
+    noteStatus(status);
+
+    return static_cast<int>(readCount);
+}
+
+int AppSignal::GetDomainInfo(TickDomain& info)
+{
+    std::lock_guard guard(samplesLock);
+
+    domain = DomainInfo::FromSignal(this->object.asPtr<ISignal>());
+    if(!domain.valid)
+        return EC_NOT_AVAILABLE;
+
+    info.origin = domain.origin;
+    info.num    = domain.num;
+    info.den    = domain.den;
+    info.delta  = domain.delta;
+    info.start  = domain.start;
+
+    const auto length = std::min(domain.unit.size(), sizeof(info.unit) - 1);
+    memcpy(info.unit, domain.unit.data(), length);
+    info.unit[length] = '\0';
+
+    return EC_OK;
+}
+
+int AppSignal::TicksToTime(const int64_t* ticks, int64_t* times, size_t count)
+{
+    std::lock_guard guard(samplesLock);
+
+    if(!domain.valid)
+        domain = DomainInfo::FromSignal(this->object.asPtr<ISignal>());
+    if(!domain.valid)
+        return EC_NOT_AVAILABLE;
+
+    for(size_t i = 0; i < count; ++i)
+        times[i] = domain.toClock(ticks[i]);
+
+    return EC_OK;
+}
+
+int AppSignal::ReadLinear(double* values, size_t count, int timeout, TimeAxis& axis, TimeBreak* breaks, size_t maxBreaks)
+{
+    std::lock_guard guard(samplesLock);
+    ReaderStatusPtr status;
+
+    // checked before the reader is touched, a typed reader stays as it is when this fails
+    const bool current = reader != nullptr && readerFormat == ReadFormat{};
+    const auto linear = current ? domain : DomainInfo::FromSignal(this->object.asPtr<ISignal>());
+    if(!linear.valid || !linear.linear())
+        return EC_NOT_AVAILABLE;
+
+    prepareReader({});
+
+    if(tickScratch.size() < count)
+        tickScratch.resize(count);
+
+    SizeT readCount = count;
+    reader.readWithDomain(values, tickScratch.data(), &readCount, readTimeout(timeout), &status);
+
+    CompressTimeAxis(
+        tickScratch.data(), readCount, domain.delta, 0, domain.seconds(domain.delta),
+        [this](int64_t tick) { return domain.toClock(tick); },
+        axis, breaks, maxBreaks
+    );
+
+    noteStatus(status);
+
+    return static_cast<int>(readCount);
+}
+
+int AppSignal::ReadEnvelope(size_t count, size_t bins, double* min, double* max, double* first, double* last,
+                            int64_t* binTimes, int timeout)
+{
+    std::lock_guard guard(samplesLock);
+    ReaderStatusPtr status;
+
+    prepareReader({});
+
+    if(blockValues.size() < count)
+        blockValues.resize(count);
+    if(binTimes && blockTimes.size() < count)
+        blockTimes.resize(count);
+
+    SizeT readCount = count;
+    readTimed(blockValues.data(), binTimes ? blockTimes.data() : nullptr, readCount, timeout, status);
+
+    // the bin width follows the requested count, so a short read fills fewer bins
+    const size_t perBin = (count + bins - 1) / bins;
+    const size_t written = EnvelopeKernel(blockValues.data(), readCount, perBin, min, max, first, last);
+
+    for(size_t bin = 0; binTimes && bin < written; ++bin)
+        binTimes[bin] = blockTimes[bin * perBin];
+
+    noteStatus(status);
+
+    return static_cast<int>(written);
+}
+
+int AppSignal::ReadStats(size_t count, int timeout, BlockStats& stats)
+{
+    std::lock_guard guard(samplesLock);
+    ReaderStatusPtr status;
+
+    prepareReader({});
+
+    if(blockValues.size() < count)
+        blockValues.resize(count);
+
+    SizeT readCount = count;
+    reader.read(blockValues.data(), &readCount, readTimeout(timeout), &status);
+
+    StatsKernel(blockValues.data(), readCount, stats);
+    noteStatus(status);
+
+    return static_cast<int>(readCount);
+}
+
+// Values of a dimension are laid out flat, the sample holds the product of all sizes
+static size_t ElementsOf(const DataDescriptorPtr& descriptor)
+{
+    size_t elements = 1;
+
+    if(descriptor.assigned() && descriptor.getDimensions().assigned())
+        for(const auto& dimension : descriptor.getDimensions())
+            elements *= dimension.getSize();
+
+    return elements;
+}
+
+// getData() of a packet returns post-scaled values, in the scaling's output type
+static SampleType DataTypeOf(const DataDescriptorPtr& descriptor)
+{
+    if(!descriptor.assigned())
+        return SampleType::Invalid;
+
+    const auto scaling = descriptor.getPostScaling();
+    return scaling.assigned() ? static_cast<SampleType>(scaling.getOutputSampleType()) : descriptor.getSampleType();
+}
+
+template <typename Target>
+static bool ConvertSamples(SampleType type, const void* source, size_t count, Target* target)
+{
+    const auto copy = [source, count, target](auto typed)
+    {
+        const auto begin = static_cast<decltype(typed)>(source);
+        std::copy(begin, begin + count, target);
+        return true;
+    };
+
+    switch(type) {
+        case SampleType::Float32: return copy(static_cast<const float*>(nullptr));
+        case SampleType::Float64: return copy(static_cast<const double*>(nullptr));
+        case SampleType::UInt8:   return copy(static_cast<const uint8_t*>(nullptr));
+        case SampleType::Int8:    return copy(static_cast<const int8_t*>(nullptr));
+        case SampleType::UInt16:  return copy(static_cast<const uint16_t*>(nullptr));
+        case SampleType::Int16:   return copy(static_cast<const int16_t*>(nullptr));
+        case SampleType::UInt32:  return copy(static_cast<const uint32_t*>(nullptr));
+        case SampleType::Int32:   return copy(static_cast<const int32_t*>(nullptr));
+        case SampleType::UInt64:  return copy(static_cast<const uint64_t*>(nullptr));
+        case SampleType::Int64:   return copy(static_cast<const int64_t*>(nullptr));
+        default:                  return false;
+    }
+}
+
+int AppSignal::GetDimensions(uint64_t& elements, double* labels, size_t cap)
+{
+    const auto descriptor = this->object.asPtr<ISignal>().getDescriptor();
+
+    elements = ElementsOf(descriptor);
+    if(!descriptor.assigned() || !descriptor.getDimensions().assigned() || descriptor.getDimensions().getCount() == 0)
+        return EC_NOT_AVAILABLE;
+
+    if(!labels)
+        return EC_OK;
+
+    const auto dimensions = descriptor.getDimensions();
+    if(dimensions.getCount() != 1)
+        return EC_METHOD_NOT_IMPLEMENTED;
+
+    if(cap < elements)
+        return EC_INSUFFICIENT_SIZE;
+
+    const auto axis = dimensions[0].getLabels();
+    for(size_t i = 0; i < elements; ++i)
+        labels[i] = static_cast<Float>(axis.getItemAt(i));
+
+    return EC_OK;
+}
+
+bool AppSignal::applyPacketEvent(PacketRead& read, const EventPacketPtr& packet)
+{
+    if(std::string(packet.getEventId()) != event_packet_id::DATA_DESCRIPTOR_CHANGED)
+        return false;
+
+    const auto params = packet.getParameters();
+    const auto param = [&params](const char* name) -> DataDescriptorPtr
+    {
+        return params.hasKey(name) ? params.get(name) : nullptr;
+    };
+
+    const auto value = param(event_packet_param::DATA_DESCRIPTOR);
+    const auto domain = param(event_packet_param::DOMAIN_DATA_DESCRIPTOR);
+
+    if(domain.assigned()) {
+        read.domainType = domain.getSampleType();
+        read.domain = DomainInfo::FromDescriptor(domain);
+    }
+
+    if(!value.assigned())
+        return false;
+
+    const size_t elements = ElementsOf(value);
+    const size_t sampleSize = value.getRawSampleSize();
+    const bool changed = elements != read.elements || sampleSize != read.sampleSize;
+
+    read.type = DataTypeOf(value);
+    read.elements = elements;
+    read.sampleSize = sampleSize;
+
+    return changed;
+}
+
+AppSignal::PacketRead& AppSignal::packetRead(std::unique_ptr<PacketRead>& read)
+{
+    if(read)
+        return *read;
+
+    const auto signal = this->object.asPtr<ISignal>();
+    const auto descriptor = signal.getDescriptor();
+
+    // seeded from the signal, the first packet of the reader is a descriptor event anyway
+    read = std::make_unique<PacketRead>();
+    read->reader = PacketReader(signal);
+    read->type = DataTypeOf(descriptor);
+    read->elements = ElementsOf(descriptor);
+    read->sampleSize = descriptor.assigned() ? descriptor.getRawSampleSize() : 0;
+
+    const auto domainSignal = signal.getDomainSignal();
+    if(domainSignal.assigned() && domainSignal.getDescriptor().assigned()) {
+        read->domainType = domainSignal.getDescriptor().getSampleType();
+        read->domain = DomainInfo::FromSignal(signal);
+    }
+
+    return *read;
+}
+
+bool AppSignal::nextPacket(PacketRead& read, bool partial, std::chrono::steady_clock::time_point deadline)
+{
+    while(true) {
+        const auto packet = read.reader.read();
+
+        if(!packet.assigned()) {
+            // packet readers do not wait, so poll until the timeout
+            if((partial && timeoutType == ReadTimeoutType::Any) || std::chrono::steady_clock::now() >= deadline)
+                return false;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        if(packet.getType() == PacketType::Event) {
+            const EventPacketPtr event = packet;
+            lastRead.events |= EventFlagsOf(event, lastRead);
+
+            // a block never mixes sample layouts
+            if(applyPacketEvent(read, event) && partial) {
+                lastRead.status = READ_STATUS_EVENT;
+                return false;
+            }
+            continue;
+        }
+
+        if(packet.getType() != PacketType::Data)
+            continue;
+
+        read.pending = packet;
+        read.offset = 0;
+        return true;
+    }
+}
+
+bool AppSignal::packetTimestamps(const PacketRead& read, const DataPacketPtr& packet, size_t n, int64_t* timestamps)
+{
+    const auto domainPacket = packet.getDomainPacket();
+    if(!domainPacket.assigned())
+        return true;
+
+    const auto ticks = static_cast<const uint8_t*>(domainPacket.getData())
+                     + read.offset * getSampleSize(read.domainType);
+    if(!ConvertSamples(read.domainType, ticks, n, timestamps))
+        return false;
+
+    for(size_t i = 0; read.domain.valid && i < n; ++i)
+        timestamps[i] = read.domain.toClock(timestamps[i]);
+    return true;
+}
+
+template <typename Copy>
+int AppSignal::readPackets(PacketRead& read, int64_t* timestamps, size_t count, int timeout, Copy&& copy)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(readTimeout(timeout));
+    size_t written = 0;
+
+    lastRead.status = READ_STATUS_OK;
+
+    while(written < count) {
+        if(!read.pending.assigned() && !nextPacket(read, written != 0, deadline))
+            break;
+
+        const DataPacketPtr packet = read.pending;
+        const size_t n = std::min<size_t>(packet.getSampleCount() - read.offset, count - written);
+
+        if(const int result = copy(packet, read.offset, n, written); result != EC_OK) {
+            lastRead.status = READ_STATUS_FAIL;
+            return result;
+        }
+
+        if(timestamps && !packetTimestamps(read, packet, n, timestamps + written)) {
+            lastRead.status = READ_STATUS_FAIL;
+            return EC_OBJECT_TYPE_MISMATCH;
+        }
+
+        written += n;
+        read.offset += n;
+
+        if(read.offset == packet.getSampleCount())
+            read.pending = nullptr;
+    }
+
+    return static_cast<int>(written);
+}
+
+int AppSignal::ReadVectors(double* values, int64_t* timestamps, size_t count, int timeout)
+{
+    std::lock_guard guard(samplesLock);
+
+    auto& read = packetRead(vectorRead);
+
+    return readPackets(read, timestamps, count, timeout,
+        [&read, values](const DataPacketPtr& packet, size_t offset, size_t n, size_t written)
+        {
+            // getData() is post-scaled, so the stride is that of the scaled type
+            const size_t stride = getSampleSize(read.type) * read.elements;
+            const auto source = static_cast<const uint8_t*>(packet.getData()) + offset * stride;
+
+            if(!ConvertSamples(read.type, source, n * read.elements, values + written * read.elements))
+                return EC_METHOD_NOT_IMPLEMENTED;
+            return EC_OK;
+        });
+}
+
+// Bytes of one element of a struct field, 0 for types without a fixed size
+static size_t FixedSampleSize(SampleType type)
+{
+    switch(type) {
+        case SampleType::Float32:
+        case SampleType::Float64:
+        case SampleType::UInt8:
+        case SampleType::Int8:
+        case SampleType::UInt16:
+        case SampleType::Int16:
+        case SampleType::UInt32:
+        case SampleType::Int32:
+        case SampleType::UInt64:
+        case SampleType::Int64:
+        case SampleType::RangeInt64:
+        case SampleType::ComplexFloat32:
+        case SampleType::ComplexFloat64:
+            return getSampleSize(type);
+        default:
+            return 0;
+    }
+}
+
+// Appends the fields of a struct descriptor from offset on, nested structs flattened as
+// "outer.inner". False for fields without a fixed size and arrays of structs
+static bool AppendStructFields(const DataDescriptorPtr& descriptor, const std::string& prefix,
+                               uint32_t& offset, std::vector<StructField>& fields)
+{
+    for(const auto& field : descriptor.getStructFields()) {
+        const std::string name = prefix + field.getName().toStdString();
+        const auto type = field.getSampleType();
+        const size_t elements = ElementsOf(field);
+
+        if(type == SampleType::Struct) {
+            if(elements != 1 || !AppendStructFields(field, name + ".", offset, fields))
+                return false;
+            continue;
+        }
+
+        const size_t size = FixedSampleSize(type);
+        if(size == 0)
+            return false;
+
+        StructField entry{};
+        const auto length = std::min(name.size(), sizeof(entry.name) - 1);
+        memcpy(entry.name, name.data(), length);
+        entry.sampleType = static_cast<int32_t>(type);
+        entry.offset     = offset;
+        entry.size       = static_cast<uint32_t>(size * elements);
+        entry.elements   = static_cast<uint32_t>(elements);
+
+        offset += entry.size;
+        fields.push_back(entry);
+    }
+
+    return true;
+}
+
+int AppSignal::GetStructLayout(StructField* fields, size_t cap, uint64_t& count, uint64_t& recordSize)
+{
+    const auto descriptor = this->object.asPtr<ISignal>().getDescriptor();
+
+    count = 0;
+    recordSize = 0;
+
+    if(!descriptor.assigned() || descriptor.getSampleType() != SampleType::Struct)
+        return EC_NOT_AVAILABLE;
+
+    std::vector<StructField> layout;
+    uint32_t size = 0;
+
+    // the packed layout is the packet memory itself, anything else cannot be read as records
+    if(!AppendStructFields(descriptor, "", size, layout) || size != descriptor.getRawSampleSize())
+        return EC_METHOD_NOT_IMPLEMENTED;
+
+    count = layout.size();
+    recordSize = size;
+
+    if(!fields)
+        return EC_OK;
+
+    if(cap < layout.size())
+        return EC_INSUFFICIENT_SIZE;
+
+    std::copy(layout.begin(), layout.end(), fields);
+    return EC_OK;
+}
+
+int AppSignal::ReadStructs(void* records, int64_t* timestamps, size_t count, int timeout)
+{
+    std::lock_guard guard(samplesLock);
+
+    auto& read = packetRead(structRead);
+    if(read.type != SampleType::Struct)
+        return EC_NOT_AVAILABLE;
+
+    const auto target = static_cast<uint8_t*>(records);
+
+    return readPackets(read, timestamps, count, timeout,
+        [&read, target](const DataPacketPtr& packet, size_t offset, size_t n, size_t written)
+        {
+            if(read.type != SampleType::Struct)
+                return EC_NOT_AVAILABLE;
+
+            // records match the packet memory, one copy per packet and no per field work
+            const auto source = static_cast<const uint8_t*>(packet.getRawData()) + offset * read.sampleSize;
+            memcpy(target + written * read.sampleSize, source, n * read.sampleSize);
+            return EC_OK;
+        });
+}
+
+int AppSignal::BorrowStructs(const void*& records, int64_t* timestamps, size_t count, int timeout)
+{
+    std::lock_guard guard(samplesLock);
+
+    auto& read = packetRead(structRead);
+    read.borrowed = nullptr;
+    records = nullptr;
+
+    if(read.type != SampleType::Struct)
+        return EC_NOT_AVAILABLE;
+
+    lastRead.status = READ_STATUS_OK;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(readTimeout(timeout));
+    if(!count || (!read.pending.assigned() && !nextPacket(read, false, deadline)))
+        return 0;
+
+    // the events before the packet may have changed the layout
+    if(read.type != SampleType::Struct) {
+        lastRead.status = READ_STATUS_FAIL;
+        return EC_NOT_AVAILABLE;
+    }
+
+    const DataPacketPtr packet = read.pending;
+    const size_t n = std::min<size_t>(packet.getSampleCount() - read.offset, count);
+
+    if(timestamps && !packetTimestamps(read, packet, n, timestamps)) {
+        lastRead.status = READ_STATUS_FAIL;
+        return EC_OBJECT_TYPE_MISMATCH;
+    }
+
+    records = static_cast<const uint8_t*>(packet.getRawData()) + read.offset * read.sampleSize;
+    read.borrowed = packet;
+
+    read.offset += n;
+    if(read.offset == packet.getSampleCount())
+        read.pending = nullptr;
+
+    return static_cast<int>(n);
+}
+
+int AppSignal::ReleaseStructs()
+{
+    std::lock_guard guard(samplesLock);
+
+    if(structRead)
+        structRead->borrowed = nullptr;
+    return EC_OK;
+}
+
+int AppSignal::SetReadFormat(int sampleType, bool raw)
+{
+    auto type = static_cast<SampleType>(sampleType);
+
+    if(sampleType == SAMPLE_TYPE_NATIVE) {
+        const auto descriptor = this->object.asPtr<ISignal>().getDescriptor();
+        if(!descriptor.assigned())
+            return EC_NOT_AVAILABLE;
+
+        const auto scaling = descriptor.getPostScaling();
+        type = raw && scaling.assigned() ? scaling.getInputSampleType() : descriptor.getSampleType();
+    }
+
+    switch(type) {
+        case SampleType::Float32: case SampleType::Float64:
+        case SampleType::UInt8:   case SampleType::Int8:
+        case SampleType::UInt16:  case SampleType::Int16:
+        case SampleType::UInt32:  case SampleType::Int32:
+        case SampleType::UInt64:  case SampleType::Int64:
+            break;
+        default:
+            return EC_OBJECT_TYPE_MISMATCH;
+    }
+
+    std::lock_guard guard(samplesLock);
+    typedFormat = { type, raw ? ReadMode::Raw : ReadMode::Scaled };
+
+    return static_cast<int>(type);
+}
+
+int AppSignal::ReadTypedInto(void* values, int64_t* timestamps, size_t count, int timeout)
+{
+    std::lock_guard guard(samplesLock);
+    ReaderStatusPtr status;
+
+    prepareReader(typedFormat);
+    SizeT readCount = count;
+
+    readTimed(values, timestamps, readCount, timeout, status);
+
+    noteStatus(status);
+
+    return static_cast<int>(readCount);
+}
+
+static constexpr size_t AcquisitionBlock  = 4096;
+static constexpr int    AcquisitionPollMs = 20;
+
+void AppSignal::acquire(Acquisition& acquisition, StreamReaderPtr reader)
+{
+    std::optional<TimeReader<StreamReaderPtr>> timeReader(reader);
+
+    std::vector<double> values(AcquisitionBlock);
+    std::vector<SampleData::time_point> timestamps(AcquisitionBlock);
+
+    while(acquisition.running.load(std::memory_order_acquire)) {
+        SizeT count = AcquisitionBlock;
+
+        try {
+            ReaderStatusPtr status;
+
+            // returns as soon as anything arrived, the timeout only bounds how long stop waits
+            timeReader->readWithDomain(values.data(), timestamps.data(), &count, AcquisitionPollMs, &status);
+
+            if(status.assigned() && !status.getValid()) {
+                timeReader.reset();
+                reader = StreamReaderFromExisting(reader, SampleType::Float64, SampleType::Int64);
+                timeReader.emplace(reader);
+            }
+        } catch(...) {
+            count = 0;
+            std::this_thread::sleep_for(std::chrono::milliseconds(AcquisitionPollMs));
+        }
+
+        if(count)
+            acquisition.ring.write(values.data(), reinterpret_cast<const int64_t*>(timestamps.data()), count);
+    }
+}
+
+int AppSignal::StartAcquisition(size_t ringCapacity)
+{
+    std::lock_guard guard(acquisitionLock);
+
+    if(acquisition)
+        return EC_ACQUISITION_RUNNING;
+
+    if(ringCapacity == 0 || ringCapacity > SampleRing<double>::MaxCapacity)
+        return EC_ARRAY_OUT_OF_BOUNDS;
+
+    auto reader = StreamReader(this->object.asPtr<ISignal>(), SampleType::Float64, SampleType::Int64,
+                               ReadMode::Scaled, ReadTimeoutType::Any);
+
+    acquisition = std::make_unique<Acquisition>(ringCapacity);
+    acquisition->thread = std::thread(&AppSignal::acquire, std::ref(*acquisition), reader);
+
+    return EC_OK;
+}
+
+int AppSignal::StopAcquisition()
+{
+    std::lock_guard guard(acquisitionLock);
+
+    if(!acquisition)
+        return EC_UNINITIALIZED;
+
+    acquisition->running.store(false, std::memory_order_release);
+    acquisition->thread.join();
+    acquisition.reset();
+
+    return EC_OK;
+}
+
+int AppSignal::Drain(double* values, int64_t* timestamps, size_t max)
+{
+    std::lock_guard guard(acquisitionLock);
+
+    if(!acquisition)
+        return EC_UNINITIALIZED;
+
+    max = std::min<size_t>(max, std::numeric_limits<int>::max());
+    return static_cast<int>(acquisition->ring.read(values, timestamps, max));
+}
+
+int AppSignal::GetAcquisitionStats(uint64_t& available, uint64_t& highWater, uint64_t& overruns)
+{
+    std::lock_guard guard(acquisitionLock);
+
+    if(!acquisition)
+        return EC_UNINITIALIZED;
+
+    available = acquisition->ring.size();
+    highWater = acquisition->ring.highWaterMark();
+    overruns  = acquisition->ring.overrunCount();
+
+    return EC_OK;
+}
+
+int AppSignal::SetReadTimeoutMode(int mode)
+{
+    if(mode < READ_TIMEOUT_ALL || mode > READ_TIMEOUT_NONE)
+        return EC_ARRAY_OUT_OF_BOUNDS;
+
+    std::lock_guard guard(samplesLock);
+
+    const auto type = mode == READ_TIMEOUT_ALL ? ReadTimeoutType::All : ReadTimeoutType::Any;
+    nonBlocking = mode == READ_TIMEOUT_NONE;
+
+    if(type != timeoutType) {
+        timeoutType = type;
+
+        if(reader != nullptr) {
+            reader.setOnDataAvailable(nullptr);
+            reader = nullptr;
+            prepareReader(readerFormat);
+        }
+    }
+
+    return EC_OK;
+}
+
+int AppSignal::GetAvailableCount(uint64_t& count)
+{
+    std::lock_guard guard(samplesLock);
+
+    prepareReader(readerFormat);
+    count = reader.getAvailableCount();
+
+    return EC_OK;
+}
+
+int AppSignal::SetDataCallback(DataCallbackFn fn, void* user, size_t minSamples)
+{
+    std::lock_guard guard(samplesLock);
+
+    dataCallback = { fn, user, std::max<size_t>(minSamples, 1) };
+
+    // creates the reader, so samples are queued from now on
+    prepareReader(readerFormat);
+    InstallDataCallback(reader, fn, user, dataCallback.minSamples);
+
+    return EC_OK;
+}
+
+void AppSignal::InstallDataCallback(const ReaderPtr& reader, DataCallbackFn fn, void* user, size_t minSamples)
+{
+    if(!fn) {
+        reader.setOnDataAvailable(nullptr);
+        return;
+    }
+
+    // a raw pointer, holding the reader would make it own itself through its callback
+    IReader* raw = reader.getObject();
+
+    reader.setOnDataAvailable(Procedure([raw, fn, user, minSamples]()
+    {
+        SizeT available = 0;
+        raw->getAvailableCount(&available);
+
+        if(available >= minSamples)
+            fn(user, available);
+    }));
+}
+
+AppSignal::~AppSignal()
+{
+    StopAcquisition();
+
+    if(reader.assigned())
+        reader.setOnDataAvailable(nullptr);
+}
+
+int AppSignal::GetScaling(double& scale, double& offset)
+{
+    const auto descriptor = this->object.asPtr<ISignal>().getDescriptor();
+    if(!descriptor.assigned() || !descriptor.getPostScaling().assigned()) {
+        scale = 1;
+        offset = 0;
+        return EC_NOT_AVAILABLE;
+    }
+
+    const auto scaling = descriptor.getPostScaling();
+    if(scaling.getType() != ScalingType::Linear)
+        return EC_METHOD_NOT_IMPLEMENTED;
+
+    const auto params = scaling.getParameters();
+    scale = params.get("scale");
+    offset = params.get("offset");
+    return EC_OK;
+}
+
 template <typename T>
 auto TryGet(const nlohmann::json& json_value, const T& def)
 {
@@ -640,14 +1558,7 @@ int AppSignal::LoadDataDescriptorFromJson(const string_view json)
             auto& sampleType = data["sampleType"];
             builder.setSampleType((daq::SampleType)TryGet<int>(sampleType, 0));
         }
-        if(Has(data, "dimensions"))
-        {
-            // TODO: add dimensions parsing
-            //auto& dimensions = data.at("dimensions"];
-        }
-        if(Has(data, "unit"))
-        {
-            auto& unit = data["unit"];
+        auto GetUnit = [&empty_str](nlohmann::json unit) {
             auto unitBuilder = UnitBuilder();
 
             unitBuilder.setId(TryGet<int>(unit["id"], 0));
@@ -655,8 +1566,58 @@ int AppSignal::LoadDataDescriptorFromJson(const string_view json)
             unitBuilder.setName(TryGet(unit["name"], empty_str));
             unitBuilder.setQuantity(TryGet(unit["quantity"], empty_str));
 
+            return unitBuilder.build();
+        };
+
+        // rule parameters keep their JSON type: integers stay integers (sizes), lists stay lists
+        auto GetParameter = [](const nlohmann::json& value) {
+            const auto GetNumber = [](const nlohmann::json& number) -> BaseObjectPtr {
+                if(number.is_number_integer())
+                    return Integer(number.get<int64_t>());
+                return Floating(TryGet<double>(number, 0));
+            };
+
+            if(!value.is_array())
+                return GetNumber(value);
+
+            auto list = List<IBaseObject>();
+            for(const auto& item : value)
+                list.pushBack(GetNumber(item));
+            return BaseObjectPtr(list);
+        };
+
+        if(Has(data, "dimensions"))
+        {
+            auto dimensions = List<IDimension>();
+
+            for(auto dimension : data["dimensions"]) {
+                auto dimensionBuilder = DimensionBuilder();
+
+                if(Has(dimension, "name"))
+                    dimensionBuilder.setName(TryGet(dimension["name"], empty_str));
+                if(Has(dimension, "unit"))
+                    dimensionBuilder.setUnit(GetUnit(dimension["unit"]));
+                if(Has(dimension, "dimensionRule")) {
+                    auto ruleBuilder = DimensionRuleBuilder();
+
+                    for (const auto& [key, value] : dimension["dimensionRule"].items()) {
+                        if(key == "type")
+                            ruleBuilder.setType((DimensionRuleType)TryGet<int>(value, 0));
+                        else
+                            ruleBuilder.addParameter(key, GetParameter(value));
+                    }
+                    dimensionBuilder.setRule(ruleBuilder.build());
+                }
+
+                dimensions.pushBack(dimensionBuilder.build());
+            }
+
+            builder.setDimensions(dimensions);
+        }
+        if(Has(data, "unit"))
+        {
             builder.setUnit(
-                unitBuilder.build()
+                GetUnit(data["unit"])
             );
         }
         if(Has(data, "valueRange"))
@@ -751,35 +1712,405 @@ int AppSignal::MultiReaderFirstNullRead(
     std::vector<void*> data(NumOfSignals, nullptr);
     std::vector<void*> timestamps(NumOfSignals, nullptr);
 
-    bound.timereader.readWithDomain(
-        data.data(),
-        (std::chrono::system_clock::time_point*)timestamps.data(),
-        &count
-    );
+    if(bound.timereader)
+        bound.timereader->readWithDomain(
+            data.data(),
+            (std::chrono::system_clock::time_point*)timestamps.data(),
+            &count
+        );
+    else
+        bound.multireader.readWithDomain(data.data(), timestamps.data(), &count);
     return count;
 }
 
 int AppSignal::ReadMulti(
-    const BoundMultiReader& bound, uint64_t NumOfSamples,
+    BoundMultiReader& bound, uint64_t NumOfSamples,
     int timeout, double** data, int64_t** timestamps)
 {
-    auto status = MultiReaderStatus();
+    if(bound.valueType != SampleType::Float64)
+        return EC_OBJECT_TYPE_MISMATCH;
+
+    return ReadMultiTyped(bound, NumOfSamples, timeout, reinterpret_cast<void**>(data), timestamps);
+}
+
+int AppSignal::ReadMultiTyped(
+    BoundMultiReader& bound, uint64_t NumOfSamples,
+    int timeout, void** data, int64_t** timestamps)
+{
+    MultiReaderStatusPtr status;
+    size_t count = NumOfSamples;
+
+    if(bound.timereader)
+        bound.timereader->readWithDomain(
+            data,
+            (std::chrono::system_clock::time_point*)timestamps,
+            &count,
+            bound.readTimeout(timeout),
+            &status
+        );
+    else
+        bound.multireader.readWithDomain(data, timestamps, &count, bound.readTimeout(timeout), &status);
+
+    NoteMultiStatus(bound, status);
+
+    return count;
+}
+
+int AppSignal::ReadMultiShared(
+    BoundMultiReader& bound, uint64_t NumOfSamples, int timeout,
+    double** data, int64_t* timestamps)
+{
+    const size_t signalCount = bound.valueScratch.size();
+
+    if(!timestamps) {
+        if(bound.timeScratch[0].size() < NumOfSamples)
+            bound.timeScratch[0].resize(NumOfSamples);
+        timestamps = bound.timeScratch[0].data();
+    }
+
+    if(bound.valueType != SampleType::Float64)
+        return EC_OBJECT_TYPE_MISMATCH;
+
+    // The reader aligns the signals on one domain, so the first signal's column is the group's.
+    // The others get no column: the reader skips the domain copy for a null one, the same path
+    // read() takes for all of them. Ticks are read past the TimeReader and converted once
+    std::vector<int64_t*> domains(signalCount, nullptr);
+    domains[0] = timestamps;
+
+    MultiReaderStatusPtr status;
+    size_t count = NumOfSamples;
+
+    bound.multireader.readWithDomain(data, domains.data(), &count, bound.readTimeout(timeout), &status);
+
+    // the domain of the samples just read, a descriptor change only applies after them
+    for(size_t i = 0; bound.timereader && bound.domain.valid && i < count; ++i)
+        timestamps[i] = bound.domain.toClock(timestamps[i]);
+
+    NoteMultiStatus(bound, status);
+
+    return count;
+}
+
+int AppSignal::ReadMultiToBuffer(
+    BoundMultiReader& bound, uint64_t NumOfSamples, int timeout,
+    int layout, size_t stride, double* data, int64_t* timestamps)
+{
+    const size_t signalCount = bound.valueScratch.size();
+
+    std::vector<double*> values(signalCount);
+    std::vector<int64_t*> times(signalCount);
+
+    if(layout == BUFFER_LAYOUT_PLANAR) {
+        stride = stride ? stride : NumOfSamples;
+        if(stride < NumOfSamples)
+            return EC_INSUFFICIENT_SIZE;
+
+        // the rows are the reader's own output arrays, nothing to move afterwards
+        for(size_t i = 0; i < signalCount; ++i) {
+            if(!timestamps && bound.timeScratch[i].size() < NumOfSamples)
+                bound.timeScratch[i].resize(NumOfSamples);
+            values[i] = data + i * stride;
+            times[i] = timestamps ? timestamps + i * stride : bound.timeScratch[i].data();
+        }
+
+        return ReadMulti(bound, NumOfSamples, timeout, values.data(), times.data());
+    }
+
+    if(layout != BUFFER_LAYOUT_INTERLEAVED)
+        return EC_ARRAY_OUT_OF_BOUNDS;
+
+    stride = stride ? stride : signalCount;
+    if(stride < signalCount)
+        return EC_INSUFFICIENT_SIZE;
+
+    for(size_t i = 0; i < signalCount; ++i) {
+        if(bound.valueScratch[i].size() < NumOfSamples)
+            bound.valueScratch[i].resize(NumOfSamples);
+        if(bound.timeScratch[i].size() < NumOfSamples)
+            bound.timeScratch[i].resize(NumOfSamples);
+        values[i] = bound.valueScratch[i].data();
+        times[i] = bound.timeScratch[i].data();
+    }
+
+    const int count = ReadMulti(bound, NumOfSamples, timeout, values.data(), times.data());
+    if(count <= 0)
+        return count;
+
+    InterleaveKernel(values.data(), signalCount, count, data, stride);
+    if(timestamps)
+        InterleaveKernel(times.data(), signalCount, count, timestamps, stride);
+
+    return count;
+}
+
+int AppSignal::ReadMultiLinear(
+    BoundMultiReader& bound, uint64_t NumOfSamples, int timeout,
+    double** data, TimeAxis& axis, TimeBreak* breaks, size_t maxBreaks)
+{
+    if(bound.valueType != SampleType::Float64)
+        return EC_OBJECT_TYPE_MISMATCH;
+
+    const auto& domain = bound.domain;
+    if(!domain.valid || !domain.linear())
+        return EC_NOT_AVAILABLE;
+
+    std::vector<int64_t*> timestamps(bound.timeScratch.size());
+    for(size_t i = 0; i < timestamps.size(); ++i) {
+        if(bound.timeScratch[i].size() < NumOfSamples)
+            bound.timeScratch[i].resize(NumOfSamples);
+        timestamps[i] = bound.timeScratch[i].data();
+    }
+
+    MultiReaderStatusPtr status;
     size_t count = NumOfSamples;
 
-    bound.timereader.readWithDomain(
+    if(!bound.timereader) {
+        bound.multireader.readWithDomain(data, timestamps.data(), &count, bound.readTimeout(timeout), &status);
+
+        CompressTimeAxis(
+            timestamps[0], count, domain.delta, 0, domain.seconds(domain.delta),
+            [&domain](int64_t tick) { return domain.toClock(tick); },
+            axis, breaks, maxBreaks
+        );
+
+        NoteMultiStatus(bound, status);
+        return count;
+    }
+
+    bound.timereader->readWithDomain(
         data,
-        (std::chrono::system_clock::time_point*)timestamps,
+        (std::chrono::system_clock::time_point*)timestamps.data(),
         &count,
-        timeout,
+        bound.readTimeout(timeout),
         &status
     );
 
-    //count = timeReader.getAvailableCount();
+    // The multi reader's domain already went through its TimeReader, so the steps are
+    // compared in clock ticks and may be off by one from rounding
+    const int64_t step = domain.toClock(domain.start + domain.delta) - domain.toClock(domain.start);
+
+    CompressTimeAxis(
+        timestamps[0], count, step, 1, domain.seconds(domain.delta),
+        [](int64_t time) { return time; },
+        axis, breaks, maxBreaks
+    );
+
+    NoteMultiStatus(bound, status);
+    return count;
+}
+
+int AppSignal::ReadMultiEnvelope(
+    BoundMultiReader& bound, uint64_t NumOfSamples, size_t bins, int timeout,
+    double** min, double** max, double** first, double** last, int64_t* binTimes)
+{
+    if(bound.valueType != SampleType::Float64)
+        return EC_OBJECT_TYPE_MISMATCH;
+
+    const size_t signalCount = bound.valueScratch.size();
+
+    std::vector<double*> data(signalCount);
+    std::vector<int64_t*> timestamps(signalCount);
+    for(size_t i = 0; i < signalCount; ++i) {
+        if(bound.valueScratch[i].size() < NumOfSamples)
+            bound.valueScratch[i].resize(NumOfSamples);
+        if(bound.timeScratch[i].size() < NumOfSamples)
+            bound.timeScratch[i].resize(NumOfSamples);
+        data[i] = bound.valueScratch[i].data();
+        timestamps[i] = bound.timeScratch[i].data();
+    }
+
+    MultiReaderStatusPtr status;
+    size_t count = NumOfSamples;
+
+    if(bound.timereader)
+        bound.timereader->readWithDomain(
+            data.data(),
+            (std::chrono::system_clock::time_point*)timestamps.data(),
+            &count,
+            bound.readTimeout(timeout),
+            &status
+        );
+    else
+        bound.multireader.readWithDomain(data.data(), timestamps.data(), &count, bound.readTimeout(timeout), &status);
+
+    const size_t perBin = (NumOfSamples + bins - 1) / bins;
+    size_t written = 0;
+
+    for(size_t i = 0; i < signalCount; ++i)
+        written = EnvelopeKernel(data[i], count, perBin, min[i], max[i],
+                                 first ? first[i] : nullptr, last ? last[i] : nullptr);
+
+    // the reader aligns the signals, so one time column serves all of them
+    for(size_t bin = 0; binTimes && bin < written; ++bin)
+        binTimes[bin] = timestamps[0][bin * perBin];
+
+    NoteMultiStatus(bound, status);
+    return static_cast<int>(written);
+}
+
+int AppSignal::SetMultiReadTimeoutMode(BoundMultiReader& bound, int mode)
+{
+    if(mode < READ_TIMEOUT_ALL || mode > READ_TIMEOUT_NONE)
+        return EC_ARRAY_OUT_OF_BOUNDS;
+
+    const auto type = mode == READ_TIMEOUT_ALL ? ReadTimeoutType::All : ReadTimeoutType::Any;
+    bound.nonBlocking = mode == READ_TIMEOUT_NONE;
+
+    if(type == bound.timeoutType)
+        return EC_OK;
+
+    ReplaceMultiReader(bound, MakeMultiReader(bound.daqSignalStorage, bound.valueType, bound.readMode, type));
+    bound.timeoutType = type;
+
+    MultiReaderFirstNullRead(bound, bound.signals.size());
+
+    return EC_OK;
+}
+
+int AppSignal::SetMultiReadFormat(BoundMultiReader& bound, int sampleType, bool raw)
+{
+    auto type = static_cast<SampleType>(sampleType);
+
+    // the reader converts every signal to one type, native is the first signal's
+    if(sampleType == SAMPLE_TYPE_NATIVE) {
+        const auto descriptor = bound.daqSignalStorage[0].getDescriptor();
+        if(!descriptor.assigned())
+            return EC_NOT_AVAILABLE;
+
+        const auto scaling = descriptor.getPostScaling();
+        type = raw && scaling.assigned() ? scaling.getInputSampleType() : descriptor.getSampleType();
+    }
+
+    switch(type) {
+        case SampleType::Float32: case SampleType::Float64:
+        case SampleType::UInt8:   case SampleType::Int8:
+        case SampleType::UInt16:  case SampleType::Int16:
+        case SampleType::UInt32:  case SampleType::Int32:
+        case SampleType::UInt64:  case SampleType::Int64:
+            break;
+        default:
+            return EC_OBJECT_TYPE_MISMATCH;
+    }
+
+    const auto mode = raw ? ReadMode::Raw : ReadMode::Scaled;
+    if(type == bound.valueType && mode == bound.readMode)
+        return static_cast<int>(type);
+
+    ReplaceMultiReader(bound, MakeMultiReader(bound.daqSignalStorage, type, mode, bound.timeoutType));
+    bound.valueType = type;
+    bound.readMode = mode;
+
+    MultiReaderFirstNullRead(bound, bound.signals.size());
+
+    return static_cast<int>(type);
+}
+
+void AppSignal::ReplaceMultiReader(BoundMultiReader& bound, const MultiReaderPtr& replacement)
+{
+    const bool ticks = !bound.timereader;
+
+    bound.multireader.setOnDataAvailable(nullptr);
+    bound.timereader.reset();
+    bound.multireader = replacement;
+
+    if(!ticks)
+        bound.timereader.emplace(bound.multireader);
+
+    if(bound.callback.fn)
+        InstallDataCallback(bound.multireader, bound.callback.fn, bound.callback.user, bound.callback.minSamples);
+}
+
+void AppSignal::NoteMultiStatus(BoundMultiReader& bound, const MultiReaderStatusPtr& status)
+{
+    if(!status.assigned())
+        return;
+
+    bound.lastRead.status = static_cast<int32_t>(status.getReadStatus());
+
+    if(status.getReadStatus() == ReadStatus::Event) {
+        uint32_t flags = 0;
+        for(const EventPacketPtr& packet : status.getEventPackets().getValueList())
+            flags |= EventFlagsOf(packet, bound.lastRead);
+
+        bound.lastRead.events |= flags;
+
+        if(flags & READ_EVENT_DOMAIN_DESCRIPTOR)
+            bound.domain = DomainInfo::FromSignal(bound.daqSignalStorage[0]);
+    }
+
+    if(!status.getValid()) {
+        ReplaceMultiReader(bound, MultiReaderFromExisting(bound.multireader, bound.valueType, SampleType::Int64));
+        bound.lastRead.events |= READ_EVENT_READER_REBUILT;
+    }
+}
+
+void AppSignal::TakeReadInfo(ReadInfo& from, ReadInfo& to)
+{
+    to = from;
+
+    from.events = 0;
+    from.eventCount = 0;
+    from.lastEvent[0] = '\0';
+}
+
+void AppSignal::SetMultiDataCallback(BoundMultiReader& bound, DataCallbackFn fn, void* user, size_t minSamples)
+{
+    bound.callback = { fn, user, std::max<size_t>(minSamples, 1) };
+    InstallDataCallback(bound.multireader, fn, user, bound.callback.minSamples);
+}
+
+int AppSignal::ReadMultiStats(
+    BoundMultiReader& bound, uint64_t NumOfSamples, int timeout, BlockStats* stats)
+{
+    if(bound.valueType != SampleType::Float64)
+        return EC_OBJECT_TYPE_MISMATCH;
+
+    const size_t signalCount = bound.valueScratch.size();
+
+    std::vector<double*> data(signalCount);
+    for(size_t i = 0; i < signalCount; ++i) {
+        if(bound.valueScratch[i].size() < NumOfSamples)
+            bound.valueScratch[i].resize(NumOfSamples);
+        data[i] = bound.valueScratch[i].data();
+    }
+
+    MultiReaderStatusPtr status;
+    size_t count = NumOfSamples;
+    bound.multireader.read(data.data(), &count, bound.readTimeout(timeout), &status);
+
+    // StatsKernel takes ~4 ns per sample and starting and joining a std::thread ~13 us, so a
+    // worker only pays off with a few 10k samples of its own; small blocks stay on this thread
+    constexpr size_t samplesPerWorker = 32768;
+    const size_t workers = std::max<size_t>(std::min<size_t>({ signalCount,
+                                                               std::thread::hardware_concurrency(),
+                                                               signalCount * count / samplesPerWorker + 1 }), 1);
+
+    // channels are independent, every worker reduces a contiguous range of them
+    auto reduce = [&](size_t worker)
+    {
+        const size_t last = signalCount * (worker + 1) / workers;
+        for(size_t i = signalCount * worker / workers; i < last; ++i)
+            StatsKernel(data[i], count, stats[i]);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+
+    size_t spawned = 1;
+    try {
+        for(; spawned < workers; ++spawned)
+            threads.emplace_back(reduce, spawned);
+    } catch(const std::system_error&) {
+        // out of threads, the ranges nobody took are reduced below
+    }
 
-    [[maybe_unused]]
-    daq::ReadStatus whu_happen = status.getReadStatus();
-    //std::cout << (int)whu_happen << std::endl;
+    reduce(0);
+    for(size_t worker = spawned; worker < workers; ++worker)
+        reduce(worker);
+    for(auto& thread : threads)
+        thread.join();
 
+    NoteMultiStatus(bound, status);
     return count;
 }
 
@@ -5,6 +5,8 @@
 #include <opendaq/stream_reader_ptr.h>
 #include <opendaq/time_reader.h>
 #include <opendaq/multi_reader_ptr.h>
+#include <opendaq/reader_ptr.h>
+#include <opendaq/packet_reader_ptr.h>
 
 #include <string_view>
 #include <iostream>
@@ -13,9 +15,17 @@
 #include "OpenDaqObject.h"
 
 #include "../ErrorCodes.h"
+#include "../AbiTypes.h"
 #include "stdout_redirect.h"
+#include "sample_ring.h"
+#include "domain_info.h"
 
 #include <chrono>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 struct SampleData
 {
@@ -24,6 +34,7 @@ struct SampleData
     using data_type  = double;
 
     static_assert(sizeof(time_int) == 8, "Time size has to be 64 bits");
+    static_assert(sizeof(time_point) == sizeof(int64_t), "Timestamps are handed out as int64");
 
     static constexpr inline size_t uninitialized = -1;
 
@@ -39,17 +50,44 @@ struct SampleData
     void Erase()            { readings.clear();   timestamps.clear();   readCount = -1;}
 };
 
+// Same type as DataCallback in lib.h
+using DataCallbackFn = void (*)(void* user, unsigned long long available);
+
 struct BoundMultiReader
 {
     std::vector<void*> signals;
     daq::ListPtr<daq::SignalPtr> daqSignalStorage;
 	daq::MultiReaderPtr multireader;
-	daq::TimeReader<daq::MultiReaderPtr> timereader;
+	// empty for a tick reader, its timestamps are the raw domain values
+	std::optional<daq::TimeReader<daq::MultiReaderPtr>> timereader;
+    std::mutex lock;
+
+    // Status of the last read, events pile up until MultiReader_GetReadInfo
+    ReadInfo lastRead{};
+
+    // Set by SetMultiReadTimeoutMode; a non-blocking reader reads with a zero timeout
+    daq::ReadTimeoutType timeoutType = daq::ReadTimeoutType::All;
+    bool nonBlocking = false;
+    int readTimeout(int timeout) const { return nonBlocking ? 0 : timeout; }
+
+    // Set by SetMultiReadFormat; every read that hands out doubles needs Float64
+    daq::SampleType valueType = daq::SampleType::Float64;
+    daq::ReadMode   readMode  = daq::ReadMode::Scaled;
 
-    BoundMultiReader(const daq::ListPtr<daq::SignalPtr>& from, void** signal_ptrs);
+    // Kept to reinstall it when the reader gets recreated
+    struct
+    {
+        DataCallbackFn fn         = nullptr;
+        void*          user       = nullptr;
+        size_t         minSamples = 1;
+    } callback;
 
-    BoundMultiReader(BoundMultiReader&&) = default;
-    BoundMultiReader& operator=(BoundMultiReader&&) = default;
+    // Domain of the first signal and per-signal timestamp scratch for linear reads
+    daq::DomainInfo domain;
+    std::vector<std::vector<int64_t>> timeScratch;
+    std::vector<std::vector<double>> valueScratch;
+
+    BoundMultiReader(const daq::ListPtr<daq::SignalPtr>& from, void** signal_ptrs, bool ticks = false);
 };
 
 BEGIN_NAMESPACE_OPENDAQ
@@ -59,6 +97,8 @@ class AppDescriptor;
 class AppSignal : public OpenDaqObjectStaticImpl<OpenDaqObject, AppSignal, SignalPtr>
 {
 public:
+    static constexpr ObjectTag Tag = ObjectTag::Signal;
+
     static bool             processCommand(OpenDaqObject& output, const std::vector<std::string>& command);
     /*
     virtual void             help    () override;
@@ -70,6 +110,67 @@ public:
 
 
     virtual int Read(size_t NumOfSamples, int timeout);
+    // Reads straight into caller memory, timestamps may be null. Returns the samples read
+    virtual int ReadInto(double* values, int64_t* timestamps, size_t count, int timeout);
+
+    // Picks the value type and mode of ReadTypedInto. SAMPLE_TYPE_NATIVE resolves to the
+    // descriptor's type, or to the post-scaling input type in raw mode. Returns the resolved type
+    virtual int SetReadFormat(int sampleType, bool raw);
+    // Reads in the format chosen by SetReadFormat; values holds count elements of that type
+    virtual int ReadTypedInto(void* values, int64_t* timestamps, size_t count, int timeout);
+    // Like ReadInto, but the timestamps are the raw domain ticks. GetDomainInfo describes them,
+    // TicksToTime converts the ones a caller actually needs
+    virtual int ReadTicksInto(double* values, int64_t* ticks, size_t count, int timeout);
+    virtual int GetDomainInfo(TickDomain& info);
+    virtual int TicksToTime(const int64_t* ticks, int64_t* times, size_t count);
+    // Reads values and describes their timestamps as t0, dt and the places the spacing breaks.
+    // The domain stays in ticks, only t0 and the break times get converted
+    virtual int ReadLinear(double* values, size_t count, int timeout, TimeAxis& axis, TimeBreak* breaks, size_t maxBreaks);
+    // Reads count samples and reduces them to bins of ceil(count / bins) samples: min and max,
+    // optionally first, last and the time of the first sample. Returns the bins written
+    virtual int ReadEnvelope(size_t count, size_t bins, double* min, double* max, double* first, double* last,
+                             int64_t* binTimes, int timeout);
+    // Reads count samples and returns only their statistics
+    virtual int ReadStats(size_t count, int timeout, BlockStats& stats);
+    // Vector samples (descriptors with dimensions, e.g. spectra). elements is the values per
+    // sample, labels (optional, one-dimensional only) the bin axis of the dimension rule
+    virtual int GetDimensions(uint64_t& elements, double* labels, size_t cap);
+    // Reads count samples as one flat [count x elements] block, timestamps may be null.
+    // Stops at a descriptor change, so a block never mixes vector lengths
+    virtual int ReadVectors(double* values, int64_t* timestamps, size_t count, int timeout);
+    // Packed record layout of a struct signal, nested structs flattened into their fields.
+    // count receives the fields of the layout, fields are only written when cap is enough
+    virtual int GetStructLayout(StructField* fields, size_t cap, uint64_t& count, uint64_t& recordSize);
+    // Copies count struct samples as contiguous records in the GetStructLayout layout
+    virtual int ReadStructs(void* records, int64_t* timestamps, size_t count, int timeout);
+    // Points records at up to count struct samples in the packet memory itself, never past the
+    // end of one packet. The packet is held until the next BorrowStructs or ReleaseStructs
+    virtual int BorrowStructs(const void*& records, int64_t* timestamps, size_t count, int timeout);
+    virtual int ReleaseStructs();
+    // Coefficients of a linear post scaling, what raw reads leave to the caller
+    virtual int GetScaling(double& scale, double& offset);
+
+    // Background acquisition: a library thread drains a reader of its own into a ring,
+    // Drain copies out whatever has arrived without blocking
+    virtual int StartAcquisition(size_t ringCapacity);
+    virtual int StopAcquisition();
+    virtual int Drain(double* values, int64_t* timestamps, size_t max);
+    virtual int GetAcquisitionStats(uint64_t& available, uint64_t& highWater, uint64_t& overruns);
+
+    // READ_TIMEOUT_ALL/ANY need a reader of that kind, so switching between them recreates it
+    // and drops the queued samples. READ_TIMEOUT_NONE reads with a zero timeout
+    virtual int SetReadTimeoutMode(int mode);
+    // Samples queued in the reader of Read/ReadInto/ReadTypedInto, creating it if needed
+    virtual int GetAvailableCount(uint64_t& count);
+    // Status of the last read and the events seen since the previous call, which clears them
+    virtual int GetReadInfo(ReadInfo& info);
+
+    // Calls fn(user, available) on the packet thread whenever a packet arrives and at least
+    // minSamples are queued in the signal's reader. fn = nullptr removes the callback
+    virtual int SetDataCallback(DataCallbackFn fn, void* user, size_t minSamples);
+    static void InstallDataCallback(const ReaderPtr& reader, DataCallbackFn fn, void* user, size_t minSamples);
+
+    ~AppSignal() override;
 
     virtual void SendDataPacket(double* data, size_t count);
     virtual void SendTestDataPacket(size_t count, double sine_range);
@@ -77,14 +178,47 @@ public:
     virtual int LoadDataDescriptorFromJson(const string_view json);
 
     SampleData samples{};
+    // Guards samples and the reader, so different signals can be read concurrently
+    std::mutex samplesLock;
 
     static int MultiReaderFirstNullRead(
         const BoundMultiReader& bound, size_t NumOfSignals);
 
     static int ReadMulti(
-        const BoundMultiReader& bound, uint64_t NumOfSamples,
+        BoundMultiReader& bound, uint64_t NumOfSamples,
         int timeout, double** data, int64_t** timestamps);
 
+    // ReadMulti in the SetMultiReadFormat type, data holds one array of that type per signal
+    static int ReadMultiTyped(
+        BoundMultiReader& bound, uint64_t NumOfSamples,
+        int timeout, void** data, int64_t** timestamps);
+    static int SetMultiReadFormat(BoundMultiReader& bound, int sampleType, bool raw);
+
+    // ReadMulti with one timestamp column for the whole group
+    static int ReadMultiShared(
+        BoundMultiReader& bound, uint64_t NumOfSamples, int timeout,
+        double** data, int64_t* timestamps);
+
+    // ReadMulti into one buffer in a BufferLayouts layout, stride elements between rows
+    static int ReadMultiToBuffer(
+        BoundMultiReader& bound, uint64_t NumOfSamples, int timeout,
+        int layout, size_t stride, double* data, int64_t* timestamps);
+
+    static int ReadMultiLinear(
+        BoundMultiReader& bound, uint64_t NumOfSamples, int timeout,
+        double** data, TimeAxis& axis, TimeBreak* breaks, size_t maxBreaks);
+
+    static int ReadMultiEnvelope(
+        BoundMultiReader& bound, uint64_t NumOfSamples, size_t bins, int timeout,
+        double** min, double** max, double** first, double** last, int64_t* binTimes);
+
+    static int SetMultiReadTimeoutMode(BoundMultiReader& bound, int mode);
+    static void TakeReadInfo(ReadInfo& from, ReadInfo& to);
+    static void SetMultiDataCallback(BoundMultiReader& bound, DataCallbackFn fn, void* user, size_t minSamples);
+
+    static int ReadMultiStats(
+        BoundMultiReader& bound, uint64_t NumOfSamples, int timeout, BlockStats* stats);
+
 private:
     static void help();
     static int print(const SignalPtr& signal, const string_view item);
@@ -108,7 +242,97 @@ private:
     friend AppDescriptor;
     friend OpenDaqObjectStaticImpl<OpenDaqObject, AppSignal, SignalPtr>;
 
+    struct ReadFormat
+    {
+        SampleType valueType = SampleType::Float64;
+        ReadMode   mode      = ReadMode::Scaled;
+
+        bool operator==(const ReadFormat& other) const
+        {
+            return valueType == other.valueType && mode == other.mode;
+        }
+        bool operator!=(const ReadFormat& other) const { return !(*this == other); }
+    };
+
+    // Created on the first read and kept, so steady-state reads do not allocate a reader.
+    // Asking for another format recreates it, which drops the samples queued in the old one
+    void prepareReader(const ReadFormat& format);
+    // The reader hands out raw ticks, so time and tick reads share it; time reads convert
+    // with domain, which noteStatus keeps current (a read stops at a domain change)
+    void readTimed(void* values, int64_t* timestamps, SizeT& count, int timeout, ReaderStatusPtr& status);
+    // Reads record their status here. A reader invalidated by a descriptor it cannot
+    // convert is replaced by one created from it, which keeps the queued samples
+    void noteStatus(const ReaderStatusPtr& status);
+    void rebuildReader();
+    static void NoteMultiStatus(BoundMultiReader& bound, const MultiReaderStatusPtr& status);
+    static void ReplaceMultiReader(BoundMultiReader& bound, const MultiReaderPtr& replacement);
+
     StreamReaderPtr reader = nullptr;
+    ReadFormat readerFormat;
+    ReadFormat typedFormat;
+    ReadTimeoutType timeoutType = ReadTimeoutType::All;
+    bool nonBlocking = false;
+    int readTimeout(int timeout) const { return nonBlocking ? 0 : timeout; }
+    // Status of the last read, events pile up until GetReadInfo
+    ReadInfo lastRead{};
+    // Domain of the signal as of the reader's last descriptor, and the ticks of one read
+    DomainInfo domain;
+    std::vector<int64_t> tickScratch;
+    // Envelope and statistics reads land here before they get reduced
+    std::vector<double> blockValues;
+    std::vector<int64_t> blockTimes;
+
+    struct DataCallback
+    {
+        DataCallbackFn fn         = nullptr;
+        void*          user       = nullptr;
+        size_t         minSamples = 1;
+    } dataCallback;
+    // Stream readers only take scalar samples, vector and struct reads work on the packets
+    // and keep the part of a packet a read did not take
+    struct PacketRead
+    {
+        PacketReaderPtr reader;
+        DataPacketPtr   pending;
+        size_t          offset     = 0;
+        SampleType      type       = SampleType::Invalid;
+        size_t          elements   = 0;
+        size_t          sampleSize = 0;    // raw bytes per sample
+        SampleType      domainType = SampleType::Invalid;
+        DomainInfo      domain;
+        DataPacketPtr   borrowed;          // packet BorrowStructs handed out
+    };
+
+    PacketRead& packetRead(std::unique_ptr<PacketRead>& read);
+    // Applies a descriptor change event, returns true if the sample layout changed
+    static bool applyPacketEvent(PacketRead& read, const EventPacketPtr& packet);
+    // Makes the next data packet pending, applying the events before it. False when none came
+    // before the deadline or a layout change has to end a block that already has samples
+    bool nextPacket(PacketRead& read, bool partial, std::chrono::steady_clock::time_point deadline);
+    // Converts the domain of n samples from the pending offset into timestamps
+    static bool packetTimestamps(const PacketRead& read, const DataPacketPtr& packet, size_t n, int64_t* timestamps);
+    // Runs copy(packet, offset, n, written) over the packets until count samples were taken,
+    // fills timestamps and returns the samples read or an error code of copy
+    template <typename Copy>
+    int readPackets(PacketRead& read, int64_t* timestamps, size_t count, int timeout, Copy&& copy);
+
+    std::unique_ptr<PacketRead> vectorRead;
+    std::unique_ptr<PacketRead> structRead;
+
+    struct Acquisition
+    {
+        explicit Acquisition(size_t capacity) : ring(capacity) {}
+
+        SampleRing<double> ring;
+        std::atomic<bool>  running{true};
+        std::thread        thread;
+    };
+
+    static void acquire(Acquisition& acquisition, StreamReaderPtr reader);
+
+    // Taken by start, stop and drain; the ring has a single consumer
+    std::mutex acquisitionLock;
+    std::unique_ptr<Acquisition> acquisition;
 };
 
 END_NAMESPACE_OPENDAQ
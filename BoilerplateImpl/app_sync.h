@@ -13,6 +13,8 @@ BEGIN_NAMESPACE_OPENDAQ
 class AppSync : public OpenDaqObjectStaticImpl<OpenDaqObject, AppSync, SyncComponentPtr>
 {
 public:
+    static constexpr ObjectTag Tag = ObjectTag::Sync;
+
     static bool processCommand(OpenDaqObject& channel, const std::vector<std::string>& command);
 
     virtual ::String get(const string_view item) override
@@ -0,0 +1,452 @@
+#include "component_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "opendaq/opendaq.h"
+
+#include "app_channel.h"
+#include "app_descriptor.h"
+#include "app_device.h"
+#include "app_function_block.h"
+#include "app_input_port.h"
+#include "app_property_object.h"
+#include "app_signal.h"
+#include "app_sync.h"
+
+BEGIN_NAMESPACE_OPENDAQ
+
+struct ResolvedEntry
+{
+    const void*   root;
+    bool          byId;
+    std::string   text;
+    BaseObjectPtr object;
+    ObjectTag     tag;
+};
+
+static std::atomic<uint64_t> topologyEpoch{1};
+
+static std::shared_mutex resolvedLock;
+static std::unordered_multimap<size_t, ResolvedEntry> resolved;
+static uint64_t resolvedEpoch = 0;
+
+// The device reference keeps the identity key from being reused while the entry exists
+struct DeviceChildren
+{
+    DevicePtr device;
+    std::array<ChildListPtr, static_cast<size_t>(ChildList::Count)> lists;
+};
+
+static std::shared_mutex childrenLock;
+static std::unordered_map<const void*, DeviceChildren> children;
+static uint64_t childrenEpoch = 0;
+
+// Keys point into the global ID strings, which are immutable and owned by ids
+struct SignalIndex
+{
+    InstancePtr instance;
+    std::vector<StringPtr> ids;
+    std::unordered_map<string_view, SignalPtr> byId;
+};
+
+static std::shared_mutex signalIndexLock;
+static std::unordered_map<const void*, std::shared_ptr<const SignalIndex>> signalIndexes;
+static uint64_t signalIndexEpoch = 0;
+
+static const void* IdentityOf(const BaseObjectPtr& object)
+{
+    return object.asPtr<IBaseObject>(true).getObject();
+}
+
+// Hashes the view directly, so a cache hit does not allocate a key string
+static size_t KeyOf(const void* root, bool byId, const string_view text)
+{
+    return std::hash<string_view>()(text) ^ (std::hash<const void*>()(root) * 31) ^ byId;
+}
+
+static bool FindResolved(const void* root, bool byId, const string_view text, BaseObjectPtr& object, ObjectTag& tag)
+{
+    std::shared_lock guard(resolvedLock);
+
+    if (resolvedEpoch != topologyEpoch.load())
+        return false;
+
+    auto [first, last] = resolved.equal_range(KeyOf(root, byId, text));
+    for (auto it = first; it != last; ++it)
+    {
+        const auto& entry = it->second;
+        if (entry.root == root && entry.byId == byId && entry.text == text)
+        {
+            object = entry.object;
+            tag = entry.tag;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void StoreResolved(uint64_t observedEpoch, const void* root, bool byId, const string_view text,
+                          const BaseObjectPtr& object, ObjectTag tag)
+{
+    std::unique_lock guard(resolvedLock);
+
+    // the tree changed while resolving, the result may already be stale
+    if (observedEpoch != topologyEpoch.load() || observedEpoch < resolvedEpoch)
+        return;
+
+    if (observedEpoch != resolvedEpoch)
+    {
+        resolved.clear();
+        resolvedEpoch = observedEpoch;
+    }
+
+    resolved.emplace(KeyOf(root, byId, text), ResolvedEntry{root, byId, std::string(text), object, tag});
+}
+
+void ComponentCache::Subscribe(const ContextPtr& context)
+{
+    context.getOnCoreEvent() += [](const ComponentPtr& /*component*/, const CoreEventArgsPtr& args)
+    {
+        switch (static_cast<CoreEventId>(args.getEventId()))
+        {
+            case CoreEventId::ComponentAdded:
+            case CoreEventId::ComponentRemoved:
+            case CoreEventId::ComponentUpdateEnd:
+            // visibility changes what getSignals returns
+            case CoreEventId::AttributeChanged:
+                Invalidate();
+                break;
+            default: ;
+        }
+    };
+}
+
+uint64_t ComponentCache::Epoch()
+{
+    return topologyEpoch.load();
+}
+
+void ComponentCache::Invalidate()
+{
+    ++topologyEpoch;
+}
+
+static string_view NormalizeType(const string_view type)
+{
+    if (type == "dev")
+        return "device";
+    if (type == "fb")
+        return "function-block";
+    return type;
+}
+
+// Children of devices, channels and function blocks only change with the topology events
+// the epoch follows. A signal's descriptor, domain signal and related signals or the signal
+// connected to an input port change without one, so paths through those are not cached
+static bool IsContainer(ObjectTag tag)
+{
+    return tag == ObjectTag::Device || tag == ObjectTag::Channel || tag == ObjectTag::FunctionBlock;
+}
+
+static bool ParseIndex(const string_view token, uint64_t& index)
+{
+    if (token.empty())
+        return false;
+
+    uint64_t value = 0;
+    for (char c : token)
+    {
+        if (c < '0' || c > '9')
+            return false;
+        value = value * 10 + (c - '0');
+    }
+
+    index = value;
+    return true;
+}
+
+BaseObjectPtr ComponentCache::Resolve(OpenDaqObject& root, const string_view path, ObjectTag& tag,
+                                      OpenDaqObjectPtr* built)
+{
+    const auto rootId = IdentityOf(root.object);
+    BaseObjectPtr object;
+
+    if (FindResolved(rootId, false, path, object, tag))
+        return object;
+
+    const auto epoch = Epoch();
+
+    OpenDaqObject* current = &root;
+    OpenDaqObjectPtr owned;
+    bool cacheable = true;
+
+    size_t pos = 0;
+    auto nextToken = [&]() -> string_view
+    {
+        while (pos < path.size() && path[pos] == '/')
+            ++pos;
+
+        const auto end = std::min(path.find('/', pos), path.size());
+        const auto token = path.substr(pos, end - pos);
+        pos = end;
+        return token;
+    };
+
+    for (auto type = nextToken(); !type.empty(); )
+    {
+        uint64_t index = 0;
+        auto next = nextToken();
+
+        if (ParseIndex(next, index))
+            next = nextToken();
+
+        cacheable = cacheable && IsContainer(current->tag);
+
+        auto child = current->select(NormalizeType(type), index);
+        if (!child)
+            return nullptr;
+
+        owned = std::move(child);
+        current = owned.get();
+        type = next;
+    }
+
+    if (!owned)
+        return nullptr;
+
+    tag = owned->tag;
+    if (cacheable)
+        StoreResolved(epoch, rootId, false, path, owned->object, tag);
+
+    BaseObjectPtr object = owned->object;
+    if (built)
+        *built = std::move(owned);
+    return object;
+}
+
+BaseObjectPtr ComponentCache::Select(OpenDaqObject& root, const string_view type, uint64_t index, ObjectTag& tag,
+                                     OpenDaqObjectPtr* built)
+{
+    // "<type>/<index>" is formatted on the stack, a cached selection does not allocate
+    char path[64];
+    if (type.empty() || type.size() + 1 + 20 > sizeof(path))
+        return nullptr;
+
+    std::copy(type.begin(), type.end(), path);
+    path[type.size()] = '/';
+    const auto end = std::to_chars(path + type.size() + 1, path + sizeof(path), index).ptr;
+
+    return Resolve(root, string_view(path, end - path), tag, built);
+}
+
+BaseObjectPtr ComponentCache::FindById(const OpenDaqObject& root, const string_view globalId, ObjectTag& tag)
+{
+    const auto rootId = IdentityOf(root.object);
+    BaseObjectPtr object;
+
+    if (FindResolved(rootId, true, globalId, object, tag))
+        return object;
+
+    const auto epoch = Epoch();
+
+    const auto folder = root.object.asPtrOrNull<IFolder>();
+    if (!folder.assigned())
+        return nullptr;
+
+    // global IDs are "<root global ID>/<local path>", findComponent wants the local part
+    const std::string rootGlobalId = folder.getGlobalId();
+    if (globalId.size() <= rootGlobalId.size() + 1 ||
+        globalId.compare(0, rootGlobalId.size(), rootGlobalId) != 0 ||
+        globalId[rootGlobalId.size()] != '/')
+        return nullptr;
+
+    const auto relative = globalId.substr(rootGlobalId.size() + 1);
+    const ComponentPtr component = folder.findComponent(daq::String(relative.data(), relative.size()));
+    if (!component.assigned())
+        return nullptr;
+
+    tag = TagOf(component);
+    if (tag == ObjectTag::Unknown)
+        return nullptr;
+
+    StoreResolved(epoch, rootId, true, globalId, component, tag);
+    return component;
+}
+
+static ChildListPtr ListChildren(const DevicePtr& device, ChildList kind)
+{
+    auto list = std::make_shared<std::vector<BaseObjectPtr>>();
+    auto append = [&list](const auto& items)
+    {
+        list->reserve(items.getCount());
+        for (const auto& item : items)
+            list->push_back(item);
+    };
+
+    switch (kind)
+    {
+        case ChildList::Devices:
+            append(device.getDevices());
+            break;
+        case ChildList::FunctionBlocks:
+            append(device.getFunctionBlocks());
+            break;
+        case ChildList::Channels:
+            append(device.getChannels());
+            break;
+        case ChildList::Signals:
+            append(device.getSignals());
+            break;
+        default: ;
+    }
+    return list;
+}
+
+ChildListPtr ComponentCache::Children(const DevicePtr& device, ChildList kind)
+{
+    const auto deviceId = IdentityOf(device);
+    const auto slot = static_cast<size_t>(kind);
+
+    {
+        std::shared_lock guard(childrenLock);
+
+        if (childrenEpoch == topologyEpoch.load())
+        {
+            auto it = children.find(deviceId);
+            if (it != children.end() && it->second.lists[slot])
+                return it->second.lists[slot];
+        }
+    }
+
+    const auto epoch = Epoch();
+    auto list = ListChildren(device, kind);
+
+    std::unique_lock guard(childrenLock);
+
+    // the tree changed while listing, hand the list out but do not keep it
+    if (epoch != topologyEpoch.load() || epoch < childrenEpoch)
+        return list;
+
+    if (epoch != childrenEpoch)
+    {
+        children.clear();
+        childrenEpoch = epoch;
+    }
+
+    auto& entry = children[deviceId];
+    entry.device = device;
+    entry.lists[slot] = list;
+    return list;
+}
+
+static std::shared_ptr<const SignalIndex> IndexSignals(const InstancePtr& instance)
+{
+    auto index = std::make_shared<SignalIndex>();
+    const auto signals = instance.getSignalsRecursive();
+
+    index->instance = instance;
+    index->ids.reserve(signals.getCount());
+    index->byId.reserve(signals.getCount());
+
+    for (const auto& signal : signals)
+    {
+        const auto& id = index->ids.emplace_back(signal.getGlobalId());
+        index->byId.emplace(string_view(id.getCharPtr(), id.getLength()), signal);
+    }
+    return index;
+}
+
+SignalPtr ComponentCache::FindSignal(const InstancePtr& instance, const string_view globalId)
+{
+    const auto instanceId = IdentityOf(instance);
+    std::shared_ptr<const SignalIndex> index;
+
+    {
+        std::shared_lock guard(signalIndexLock);
+
+        if (signalIndexEpoch == topologyEpoch.load())
+        {
+            auto it = signalIndexes.find(instanceId);
+            if (it != signalIndexes.end())
+                index = it->second;
+        }
+    }
+
+    if (!index)
+    {
+        const auto epoch = Epoch();
+        index = IndexSignals(instance);
+
+        std::unique_lock guard(signalIndexLock);
+
+        if (epoch == topologyEpoch.load() && epoch >= signalIndexEpoch)
+        {
+            if (epoch != signalIndexEpoch)
+            {
+                signalIndexes.clear();
+                signalIndexEpoch = epoch;
+            }
+            signalIndexes[instanceId] = index;
+        }
+    }
+
+    auto it = index->byId.find(globalId);
+    return it != index->byId.end() ? it->second : nullptr;
+}
+
+ObjectTag ComponentCache::TagOf(const BaseObjectPtr& object)
+{
+    // channels are function blocks too, so they have to be checked first
+    if (object.supportsInterface<IDevice>())
+        return ObjectTag::Device;
+    if (object.supportsInterface<IChannel>())
+        return ObjectTag::Channel;
+    if (object.supportsInterface<IFunctionBlock>())
+        return ObjectTag::FunctionBlock;
+    if (object.supportsInterface<ISignal>())
+        return ObjectTag::Signal;
+    if (object.supportsInterface<IInputPort>())
+        return ObjectTag::InputPort;
+    if (object.supportsInterface<ISyncComponent>())
+        return ObjectTag::Sync;
+    if (object.supportsInterface<IDataDescriptor>())
+        return ObjectTag::Descriptor;
+    if (object.supportsInterface<IPropertyObject>())
+        return ObjectTag::PropertyObject;
+
+    return ObjectTag::Unknown;
+}
+
+OpenDaqObjectPtr ComponentCache::MakeWrapper(ObjectTag tag, const BaseObjectPtr& object)
+{
+    switch (tag)
+    {
+        case ObjectTag::Device:
+            return Make_OpenDaqObjectPtr<AppDevice>(BaseObjectPtr(object));
+        case ObjectTag::Channel:
+            return Make_OpenDaqObjectPtr<AppChannel>(BaseObjectPtr(object));
+        case ObjectTag::FunctionBlock:
+            return Make_OpenDaqObjectPtr<AppFunctionBlock>(BaseObjectPtr(object));
+        case ObjectTag::Signal:
+            return Make_OpenDaqObjectPtr<AppSignal>(BaseObjectPtr(object));
+        case ObjectTag::InputPort:
+            return Make_OpenDaqObjectPtr<AppInputPort>(BaseObjectPtr(object));
+        case ObjectTag::Sync:
+            return Make_OpenDaqObjectPtr<AppSync>(BaseObjectPtr(object));
+        case ObjectTag::Descriptor:
+            return Make_OpenDaqObjectPtr<AppDescriptor>(BaseObjectPtr(object));
+        case ObjectTag::PropertyObject:
+            return Make_OpenDaqObjectPtr<AppPropertyObject>(BaseObjectPtr(object));
+        default: ;
+    }
+    return nullptr;
+}
+
+END_NAMESPACE_OPENDAQ
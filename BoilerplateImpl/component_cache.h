@@ -0,0 +1,63 @@
+#pragma once
+#include <opendaq/context_ptr.h>
+#include <opendaq/device_ptr.h>
+#include <opendaq/instance_ptr.h>
+#include <opendaq/signal_ptr.h>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "OpenDaqObject.h"
+
+BEGIN_NAMESPACE_OPENDAQ
+
+enum class ChildList : uint32_t
+{
+    Devices = 0,
+    FunctionBlocks,
+    Channels,
+    Signals,
+    Count
+};
+
+using ChildListPtr = std::shared_ptr<const std::vector<BaseObjectPtr>>;
+
+// Caches derived from the component tree. Entries are tagged with the topology epoch,
+// which openDAQ core events bump whenever components are added or removed, and are
+// dropped lazily on the first access after a change.
+class ComponentCache
+{
+public:
+    static void             Subscribe(const ContextPtr& context);
+    static uint64_t         Epoch();
+    static void             Invalidate();
+
+    // Resolves "device/0/channel/3/signal/0" style paths relative to root in one call.
+    // Every <type> is what select accepts, the index may be omitted when it is 0.
+    // Only steps out of devices, channels and function blocks are cached, paths through a
+    // signal or an input port are walked every time.
+    // When the path is not cached yet, built receives the wrapper the walk ended on
+    static BaseObjectPtr    Resolve(OpenDaqObject& root, const string_view path, ObjectTag& tag,
+                                    OpenDaqObjectPtr* built = nullptr);
+    // root.select(type, index) through the same cache as Resolve(root, "<type>/<index>")
+    static BaseObjectPtr    Select(OpenDaqObject& root, const string_view type, uint64_t index, ObjectTag& tag,
+                                   OpenDaqObjectPtr* built = nullptr);
+    // Finds a component below root by its global ID
+    static BaseObjectPtr    FindById(const OpenDaqObject& root, const string_view globalId, ObjectTag& tag);
+
+    // Children of a device as getDevices/getFunctionBlocks/getChannels/getSignals return them.
+    // The device is only asked again after a topology change, so counting and indexing
+    // in a loop does not rebuild the list (or go over the network for remote devices)
+    static ChildListPtr     Children(const DevicePtr& device, ChildList kind);
+
+    // Looks a signal up by global ID in a hash index of instance.getSignalsRecursive(),
+    // built once per topology change instead of walking every signal per lookup
+    static SignalPtr        FindSignal(const InstancePtr& instance, const string_view globalId);
+
+    static ObjectTag        TagOf(const BaseObjectPtr& object);
+    static OpenDaqObjectPtr MakeWrapper(ObjectTag tag, const BaseObjectPtr& object);
+};
+
+END_NAMESPACE_OPENDAQ
@@ -0,0 +1,95 @@
+#include "domain_info.h"
+
+#include <numeric>
+#include <sstream>
+#include <string>
+
+#include "opendaq/opendaq.h"
+
+#include <date/date.h>
+
+BEGIN_NAMESPACE_OPENDAQ
+
+int64_t DomainInfo::toClock(int64_t tick) const
+{
+    // split into whole and remainder, tick * scaleNum alone overflows for µs ticks in a few days
+    const int64_t whole = tick / scaleDen;
+    const int64_t rest  = tick % scaleDen;
+
+    return origin + whole * scaleNum + static_cast<int64_t>(static_cast<long double>(rest) * scaleNum / scaleDen);
+}
+
+bool DomainInfo::ParseOrigin(const std::string_view origin, int64_t& clockTicks)
+{
+    if (origin.empty())
+    {
+        clockTicks = 0;
+        return true;
+    }
+
+    // same formats TimeReader accepts: ISO 8601 with an offset, with Z, or a plain date
+    for (const char* format : {"%FT%T%Ez", "%FT%TZ", "%FT%T", "%F"})
+    {
+        std::istringstream stream{std::string(origin)};
+        date::sys_time<Clock::duration> time;
+
+        stream >> date::parse(format, time);
+        if (!stream.fail())
+        {
+            clockTicks = time.time_since_epoch().count();
+            return true;
+        }
+    }
+    return false;
+}
+
+DomainInfo DomainInfo::FromSignal(const SignalPtr& signal)
+{
+    const auto domain = signal.getDomainSignal();
+    if (!domain.assigned())
+        return {};
+
+    return FromDescriptor(domain.getDescriptor());
+}
+
+DomainInfo DomainInfo::FromDescriptor(const DataDescriptorPtr& descriptor)
+{
+    DomainInfo info;
+
+    if (!descriptor.assigned())
+        return info;
+
+    const auto resolution = descriptor.getTickResolution();
+    if (!resolution.assigned() || resolution.getNumerator() <= 0 || resolution.getDenominator() <= 0)
+        return info;
+
+    const StringPtr origin = descriptor.getOrigin();
+    if (!ParseOrigin(origin.assigned() ? origin.toStdString() : "", info.origin))
+        return info;
+
+    info.num = resolution.getNumerator();
+    info.den = resolution.getDenominator();
+
+    int64_t scaleNum = info.num * Clock::period::den;
+    int64_t scaleDen = info.den * Clock::period::num;
+    const int64_t divisor = std::gcd(scaleNum, scaleDen);
+    info.scaleNum = scaleNum / divisor;
+    info.scaleDen = scaleDen / divisor;
+
+    const auto unit = descriptor.getUnit();
+    if (unit.assigned() && unit.getSymbol().assigned())
+        info.unit = unit.getSymbol().toStdString();
+
+    const auto rule = descriptor.getRule();
+    if (rule.assigned() && rule.getType() == DataRuleType::Linear)
+    {
+        const auto params = rule.getParameters();
+        info.delta = params.get("delta");
+        info.start = params.get("start");
+    }
+
+    info.valid = true;
+    return info;
+}
+
+END_NAMESPACE_OPENDAQ
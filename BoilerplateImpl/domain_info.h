@@ -0,0 +1,40 @@
+#pragma once
+#include <opendaq/signal_ptr.h>
+#include <opendaq/data_descriptor_ptr.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+BEGIN_NAMESPACE_OPENDAQ
+
+// Maps the domain ticks of a signal to system_clock time the way TimeReader does, so a
+// read can stay in ticks and convert only the few values it hands out (t0, gaps)
+struct DomainInfo
+{
+    using Clock = std::chrono::system_clock;
+
+    int64_t origin = 0;         // origin as system_clock ticks since the Unix epoch
+    int64_t num    = 1;         // tick resolution in seconds, num / den
+    int64_t den    = 1;
+    int64_t delta  = 0;         // ticks between samples of a linear rule, 0 otherwise
+    int64_t start  = 0;
+    std::string unit;           // symbol of the domain unit, usually "s"
+    bool    valid  = false;
+
+    bool    linear() const { return delta != 0; }
+    double  seconds(int64_t ticks) const { return static_cast<double>(ticks) * num / den; }
+    int64_t toClock(int64_t tick) const;
+
+    static DomainInfo FromSignal(const SignalPtr& signal);
+    static DomainInfo FromDescriptor(const DataDescriptorPtr& descriptor);
+    static bool       ParseOrigin(const std::string_view origin, int64_t& clockTicks);
+
+private:
+    // tick -> clock ticks ratio, reduced so the integer math overflows as late as possible
+    int64_t scaleNum = 1;
+    int64_t scaleDen = 1;
+};
+
+END_NAMESPACE_OPENDAQ
@@ -0,0 +1,318 @@
+#include "sample_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define KERNELS_X86 1
+#endif
+
+#if defined(OPENDAQ_BRIDGE_AVX2) && defined(KERNELS_X86)
+#define KERNELS_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC takes AVX2 intrinsics in any function, the instructions are emitted where they are used
+#define AVX2_TARGET
+#else
+// only the functions marked this way are built for AVX2, the rest of the file keeps the
+// baseline target
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+
+// Scalar versions, vectorized as far as the baseline target allows
+
+void MinMaxScalar(const double* values, size_t count, double& min, double& max)
+{
+    double lo = values[0];
+    double hi = values[0];
+
+    for(size_t i = 1; i < count; ++i) {
+        lo = std::min(lo, values[i]);
+        hi = std::max(hi, values[i]);
+    }
+
+    min = lo;
+    max = hi;
+}
+
+struct Sums
+{
+    double sum     = 0;
+    double squares = 0;
+    double lo      = 0;
+    double hi      = 0;
+};
+
+void SumsScalar(const double* values, size_t begin, size_t count, double shift, Sums& sums)
+{
+    for(size_t i = begin; i < count; ++i) {
+        const double d = values[i] - shift;
+        sums.sum     += d;
+        sums.squares += d * d;
+        sums.lo = std::min(sums.lo, values[i]);
+        sums.hi = std::max(sums.hi, values[i]);
+    }
+}
+
+template <typename T>
+void InterleaveScalar(const T* const* rows, size_t channels, size_t begin, size_t end, size_t firstChannel,
+                      T* out, size_t stride)
+{
+    for(size_t c = firstChannel; c < channels; ++c) {
+        const T* row = rows[c];
+        for(size_t s = begin; s < end; ++s)
+            out[s * stride + c] = row[s];
+    }
+}
+
+constexpr size_t InterleaveBlock = 256;
+
+#if defined(KERNELS_AVX2)
+
+bool CpuHasAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 7)
+        return false;
+
+    // the OS has to save the YMM registers too (OSXSAVE, then XCR0 bits 1 and 2)
+    __cpuid(info, 1);
+    if(!(info[2] & (1 << 27)) || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool UseAvx2()
+{
+    static const bool use = CpuHasAvx2();
+    return use;
+}
+
+AVX2_TARGET void MinMaxAvx2(const double* values, size_t count, double& min, double& max)
+{
+    if(count < 8)
+        return MinMaxScalar(values, count, min, max);
+
+    // two accumulators each, so consecutive min/max do not wait on one another
+    __m256d lo0 = _mm256_loadu_pd(values);
+    __m256d lo1 = _mm256_loadu_pd(values + 4);
+    __m256d hi0 = lo0;
+    __m256d hi1 = lo1;
+    size_t i = 8;
+
+    for(; i + 8 <= count; i += 8) {
+        const __m256d a = _mm256_loadu_pd(values + i);
+        const __m256d b = _mm256_loadu_pd(values + i + 4);
+        lo0 = _mm256_min_pd(lo0, a);
+        lo1 = _mm256_min_pd(lo1, b);
+        hi0 = _mm256_max_pd(hi0, a);
+        hi1 = _mm256_max_pd(hi1, b);
+    }
+
+    alignas(32) double lanes[8];
+    _mm256_store_pd(lanes, _mm256_min_pd(lo0, lo1));
+    _mm256_store_pd(lanes + 4, _mm256_max_pd(hi0, hi1));
+
+    double lo = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+    double hi = std::max(std::max(lanes[4], lanes[5]), std::max(lanes[6], lanes[7]));
+
+    for(; i < count; ++i) {
+        lo = std::min(lo, values[i]);
+        hi = std::max(hi, values[i]);
+    }
+
+    min = lo;
+    max = hi;
+}
+
+// Returns the samples covered, SumsScalar takes the rest
+AVX2_TARGET size_t SumsAvx2(const double* values, size_t count, double shift, Sums& sums)
+{
+    if(count < 8)
+        return 0;
+
+    const __m256d k = _mm256_set1_pd(shift);
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sum1 = _mm256_setzero_pd();
+    __m256d sq0  = _mm256_setzero_pd();
+    __m256d sq1  = _mm256_setzero_pd();
+    __m256d lo0  = _mm256_set1_pd(shift);
+    __m256d lo1  = lo0;
+    __m256d hi0  = lo0;
+    __m256d hi1  = lo0;
+    size_t i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        const __m256d a = _mm256_loadu_pd(values + i);
+        const __m256d b = _mm256_loadu_pd(values + i + 4);
+        const __m256d da = _mm256_sub_pd(a, k);
+        const __m256d db = _mm256_sub_pd(b, k);
+
+        sum0 = _mm256_add_pd(sum0, da);
+        sum1 = _mm256_add_pd(sum1, db);
+        sq0  = _mm256_add_pd(sq0, _mm256_mul_pd(da, da));
+        sq1  = _mm256_add_pd(sq1, _mm256_mul_pd(db, db));
+        lo0  = _mm256_min_pd(lo0, a);
+        lo1  = _mm256_min_pd(lo1, b);
+        hi0  = _mm256_max_pd(hi0, a);
+        hi1  = _mm256_max_pd(hi1, b);
+    }
+
+    alignas(32) double lanes[16];
+    _mm256_store_pd(lanes,      _mm256_add_pd(sum0, sum1));
+    _mm256_store_pd(lanes + 4,  _mm256_add_pd(sq0, sq1));
+    _mm256_store_pd(lanes + 8,  _mm256_min_pd(lo0, lo1));
+    _mm256_store_pd(lanes + 12, _mm256_max_pd(hi0, hi1));
+
+    sums.sum     = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    sums.squares = (lanes[4] + lanes[5]) + (lanes[6] + lanes[7]);
+    sums.lo = std::min(std::min(lanes[8], lanes[9]), std::min(lanes[10], lanes[11]));
+    sums.hi = std::max(std::max(lanes[12], lanes[13]), std::max(lanes[14], lanes[15]));
+
+    return i;
+}
+
+// Transposes 4 x 4 tiles of 8-byte samples in registers. Vector loads and stores may alias
+// any type, so int64_t goes through __m256d as is. Returns the channels covered
+AVX2_TARGET size_t InterleaveAvx2(const void* const* rows, size_t channels, size_t begin, size_t end,
+                                  void* out, size_t stride)
+{
+    size_t c = 0;
+
+    for(; c + 4 <= channels; c += 4) {
+        const double* r0 = static_cast<const double*>(rows[c]);
+        const double* r1 = static_cast<const double*>(rows[c + 1]);
+        const double* r2 = static_cast<const double*>(rows[c + 2]);
+        const double* r3 = static_cast<const double*>(rows[c + 3]);
+        double* target = static_cast<double*>(out) + c;
+        size_t s = begin;
+
+        for(; s + 4 <= end; s += 4) {
+            const __m256d a = _mm256_loadu_pd(r0 + s);
+            const __m256d b = _mm256_loadu_pd(r1 + s);
+            const __m256d x = _mm256_loadu_pd(r2 + s);
+            const __m256d y = _mm256_loadu_pd(r3 + s);
+
+            const __m256d ab0 = _mm256_unpacklo_pd(a, b);    // a0 b0 a2 b2
+            const __m256d ab1 = _mm256_unpackhi_pd(a, b);    // a1 b1 a3 b3
+            const __m256d xy0 = _mm256_unpacklo_pd(x, y);
+            const __m256d xy1 = _mm256_unpackhi_pd(x, y);
+
+            _mm256_storeu_pd(target + (s + 0) * stride, _mm256_permute2f128_pd(ab0, xy0, 0x20));
+            _mm256_storeu_pd(target + (s + 1) * stride, _mm256_permute2f128_pd(ab1, xy1, 0x20));
+            _mm256_storeu_pd(target + (s + 2) * stride, _mm256_permute2f128_pd(ab0, xy0, 0x31));
+            _mm256_storeu_pd(target + (s + 3) * stride, _mm256_permute2f128_pd(ab1, xy1, 0x31));
+        }
+
+        for(; s < end; ++s) {
+            target[s * stride + 0] = r0[s];
+            target[s * stride + 1] = r1[s];
+            target[s * stride + 2] = r2[s];
+            target[s * stride + 3] = r3[s];
+        }
+    }
+
+    return c;
+}
+
+#endif
+
+template <typename T>
+void Interleave(const T* const* rows, size_t channels, size_t count, T* out, size_t stride)
+{
+    static_assert(sizeof(T) == 8, "the AVX2 tiles work on 8-byte samples");
+
+    for(size_t begin = 0; begin < count; begin += InterleaveBlock) {
+        const size_t end = std::min(begin + InterleaveBlock, count);
+        size_t c = 0;
+
+#if defined(KERNELS_AVX2)
+        if(UseAvx2())
+            c = InterleaveAvx2(reinterpret_cast<const void* const*>(rows), channels, begin, end, out, stride);
+#endif
+
+        InterleaveScalar(rows, channels, begin, end, c, out, stride);
+    }
+}
+
+} // namespace
+
+void MinMaxKernel(const double* values, size_t count, double& min, double& max)
+{
+#if defined(KERNELS_AVX2)
+    if(UseAvx2())
+        return MinMaxAvx2(values, count, min, max);
+#endif
+    MinMaxScalar(values, count, min, max);
+}
+
+void StatsKernel(const double* values, size_t count, BlockStats& stats)
+{
+    stats = BlockStats{};
+    if(count == 0)
+        return;
+
+    const double shift = values[0];
+    Sums sums;
+    sums.lo = values[0];
+    sums.hi = values[0];
+    size_t done = 0;
+
+#if defined(KERNELS_AVX2)
+    if(UseAvx2())
+        done = SumsAvx2(values, count, shift, sums);
+#endif
+
+    SumsScalar(values, done, count, shift, sums);
+
+    const double n = static_cast<double>(count);
+    const double deviation = std::max(sums.squares - sums.sum * sums.sum / n, 0.0);
+
+    stats.count      = count;
+    stats.mean       = shift + sums.sum / n;
+    stats.rms        = std::sqrt(deviation / n + stats.mean * stats.mean);
+    stats.min        = sums.lo;
+    stats.max        = sums.hi;
+    stats.stddev     = count > 1 ? std::sqrt(deviation / (n - 1)) : 0.0;
+    stats.peakToPeak = sums.hi - sums.lo;
+}
+
+size_t EnvelopeKernel(const double* values, size_t count, size_t perBin,
+                      double* min, double* max, double* first, double* last)
+{
+    size_t bin = 0;
+
+    for(size_t begin = 0; begin < count; begin += perBin, ++bin) {
+        const size_t n = std::min(perBin, count - begin);
+
+        MinMaxKernel(values + begin, n, min[bin], max[bin]);
+        if(first)
+            first[bin] = values[begin];
+        if(last)
+            last[bin] = values[begin + n - 1];
+    }
+
+    return bin;
+}
+
+void InterleaveKernel(const double* const* rows, size_t channels, size_t count, double* out, size_t stride)
+{
+    Interleave(rows, channels, count, out, stride);
+}
+
+void InterleaveKernel(const int64_t* const* rows, size_t channels, size_t count, int64_t* out, size_t stride)
+{
+    Interleave(rows, channels, count, out, stride);
+}
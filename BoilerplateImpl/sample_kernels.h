@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../AbiTypes.h"
+
+// Per-block reductions run on the read path. sample_kernels.cpp holds a scalar and, with
+// OPENDAQ_BRIDGE_AVX2, an AVX2 version of each; the AVX2 one is only called when the CPU
+// reports AVX2 at runtime, so the library itself needs nothing beyond the baseline target.
+
+// Smallest and largest of values[0..count), count has to be at least 1
+void MinMaxKernel(const double* values, size_t count, double& min, double& max);
+
+// mean, rms, min, max and standard deviation in one pass. The sums run around the first
+// value, so a small signal on a large offset does not cancel out in the variance
+void StatsKernel(const double* values, size_t count, BlockStats& stats);
+
+// Splits values into bins of perBin samples, the last one takes the remainder, and writes
+// min, max, first and last of every bin; first and last may be null. Returns the bins written
+size_t EnvelopeKernel(const double* values, size_t count, size_t perBin,
+                      double* min, double* max, double* first, double* last);
+
+// Writes rows[c][s] to out[s * stride + c] for channels rows of count samples, i.e. turns
+// planar channels into interleaved [sample][channel] records. Works in blocks of samples
+// that keep the source rows and the output lines in cache
+void InterleaveKernel(const double* const* rows, size_t channels, size_t count, double* out, size_t stride);
+void InterleaveKernel(const int64_t* const* rows, size_t channels, size_t count, int64_t* out, size_t stride);
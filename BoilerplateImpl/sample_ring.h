@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+// Lock-free single-producer/single-consumer ring of samples and their timestamps.
+//
+// head and tail only grow and are reduced by the power-of-two mask when indexing, so
+// full and empty never look alike. The producer publishes with a release store on head
+// and the consumer with one on tail; each side only writes its own index. When the
+// ring is full the newest samples are dropped and counted as overruns, so a slow
+// consumer never stalls the acquisition thread.
+template <typename Value, typename Domain = int64_t>
+class SampleRing
+{
+public:
+    // 2^28 samples take 4 GiB with int64 timestamps; larger requests are refused by the
+    // caller, so RoundUp never runs past the top bit
+    static constexpr size_t MaxCapacity = size_t(1) << 28;
+
+    // capacity has to be 1..MaxCapacity
+    explicit SampleRing(size_t capacity) :
+        mask(RoundUp(capacity) - 1),
+        values(new Value[mask + 1]),
+        domain(new Domain[mask + 1])
+    {
+    }
+
+    SampleRing(const SampleRing&) = delete;
+    SampleRing& operator=(const SampleRing&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+    size_t size()     const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+
+    // Producer side. Returns how many samples fit
+    size_t write(const Value* v, const Domain* d, size_t count)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        const size_t t = tail.load(std::memory_order_acquire);
+        const size_t n = std::min(count, capacity() - (h - t));
+
+        copy(values.get(), h, v, n);
+        copy(domain.get(), h, d, n);
+        head.store(h + n, std::memory_order_release);
+
+        if(n < count)
+            overruns.fetch_add(count - n, std::memory_order_relaxed);
+
+        const size_t used = h + n - t;
+        if(used > highWater.load(std::memory_order_relaxed))
+            highWater.store(used, std::memory_order_relaxed);
+
+        return n;
+    }
+
+    // Consumer side, never blocks. d may be null when the timestamps are not needed
+    size_t read(Value* v, Domain* d, size_t max)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        const size_t h = head.load(std::memory_order_acquire);
+        const size_t n = std::min(max, h - t);
+
+        copyOut(v, values.get(), t, n);
+        if(d)
+            copyOut(d, domain.get(), t, n);
+        tail.store(t + n, std::memory_order_release);
+
+        return n;
+    }
+
+    size_t   highWaterMark() const { return highWater.load(std::memory_order_relaxed); }
+    uint64_t overrunCount()  const { return overruns.load(std::memory_order_relaxed); }
+
+private:
+    static size_t RoundUp(size_t capacity)
+    {
+        size_t size = 1;
+        while(size < capacity)
+            size <<= 1;
+        return size;
+    }
+
+    // Copies into the ring starting at position, wrapping around at most once
+    template <typename T>
+    void copy(T* ring, size_t position, const T* from, size_t count)
+    {
+        const size_t start = position & mask;
+        const size_t first = std::min(count, capacity() - start);
+
+        std::memcpy(ring + start, from, first * sizeof(T));
+        std::memcpy(ring, from + first, (count - first) * sizeof(T));
+    }
+
+    template <typename T>
+    void copyOut(T* to, const T* ring, size_t position, size_t count)
+    {
+        const size_t start = position & mask;
+        const size_t first = std::min(count, capacity() - start);
+
+        std::memcpy(to, ring + start, first * sizeof(T));
+        std::memcpy(to + first, ring, (count - first) * sizeof(T));
+    }
+
+    const size_t              mask;
+    std::unique_ptr<Value[]>  values;
+    std::unique_ptr<Domain[]> domain;
+
+    alignas(64) std::atomic<size_t>   head{0};
+    alignas(64) std::atomic<size_t>   tail{0};
+    alignas(64) std::atomic<size_t>   highWater{0};
+    std::atomic<uint64_t>             overruns{0};
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include <utility>
+
+// Generational slot map used to hand out opaque handles over the C ABI.
+//
+// A handle packs a 32-bit slot index (low half) with the generation of that slot
+// (high half). Freeing a slot bumps its generation, so stale handles are rejected
+// even after the slot gets reused. Generations stay within 31 bits and never hit 0,
+// which keeps every valid handle non-zero and positive when stored in an int64.
+template <typename T>
+class SlotMap
+{
+public:
+    using Handle = uint64_t;
+
+    static constexpr inline Handle invalid = 0;
+
+    struct Slot
+    {
+        T        value{};
+        uint32_t generation = 1;
+        uint32_t tag        = 0;
+        bool     alive      = false;
+    };
+
+    Handle insert(T value, uint32_t tag = 0)
+    {
+        uint32_t index;
+
+        if(!freeList.empty()) {
+            index = freeList.back();
+            freeList.pop_back();
+        } else {
+            index = static_cast<uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+
+        auto& slot = slots[index];
+        slot.value = std::move(value);
+        slot.tag   = tag;
+        slot.alive = true;
+
+        return MakeHandle(index, slot.generation);
+    }
+
+    Slot* find(Handle handle)
+    {
+        const auto index = IndexOf(handle);
+
+        if(index >= slots.size())
+            return nullptr;
+
+        auto& slot = slots[index];
+        return slot.alive && slot.generation == GenerationOf(handle) ? &slot : nullptr;
+    }
+
+    bool contains(Handle handle) { return find(handle) != nullptr; }
+
+    // Moves the value out and frees the slot, so the caller decides when it is destroyed
+    bool take(Handle handle, T& out)
+    {
+        auto slot = find(handle);
+
+        if(!slot)
+            return false;
+
+        out = std::move(slot->value);
+        slot->value = T{};
+        slot->alive = false;
+        slot->generation = NextGeneration(slot->generation);
+        freeList.push_back(IndexOf(handle));
+
+        return true;
+    }
+
+    bool erase(Handle handle)
+    {
+        T value;
+        return take(handle, value);
+    }
+
+    size_t size() const { return slots.size() - freeList.size(); }
+
+    template <typename Fn>
+    void forEach(Fn&& fn)
+    {
+        for(uint32_t i = 0; i < slots.size(); ++i) {
+            if(slots[i].alive)
+                fn(MakeHandle(i, slots[i].generation), slots[i]);
+        }
+    }
+
+    static constexpr Handle   MakeHandle(uint32_t index, uint32_t generation) { return (Handle(generation) << 32) | index; }
+    static constexpr uint32_t IndexOf(Handle handle)      { return static_cast<uint32_t>(handle); }
+    static constexpr uint32_t GenerationOf(Handle handle) { return static_cast<uint32_t>(handle >> 32); }
+
+private:
+    static constexpr uint32_t NextGeneration(uint32_t generation)
+    {
+        return generation >= 0x7FFFFFFFu ? 1 : generation + 1;
+    }
+
+    std::vector<Slot>     slots;
+    std::vector<uint32_t> freeList;
+};
+
+// Thread-safe front of SlotMap that splits the handle space across independently
+// locked shards. The shard number lives in the low bits of the slot index, so a
+// lookup only takes the reader lock of the shard its handle belongs to and threads
+// working on different objects rarely contend on the same lock.
+template <typename T, uint32_t Shards = 16>
+class ShardedSlotMap
+{
+    using Map = SlotMap<T>;
+
+public:
+    using Handle = typename Map::Handle;
+
+    Handle insert(T value, uint32_t tag = 0)
+    {
+        const uint32_t shardIndex = next.fetch_add(1, std::memory_order_relaxed) % Shards;
+        auto& shard = shards[shardIndex];
+
+        std::unique_lock lock(shard.mutex);
+        const auto local = shard.map.insert(std::move(value), tag);
+
+        return Map::MakeHandle(Map::IndexOf(local) * Shards + shardIndex, Map::GenerationOf(local));
+    }
+
+    // Copies the slot contents out under a shared lock
+    bool find(Handle handle, T& value, uint32_t& tag)
+    {
+        auto& shard = shards[ShardOf(handle)];
+
+        std::shared_lock lock(shard.mutex);
+        auto slot = shard.map.find(LocalHandle(handle));
+
+        if(!slot)
+            return false;
+
+        value = slot->value;
+        tag   = slot->tag;
+        return true;
+    }
+
+    // The value is moved out so it gets destroyed after the shard lock is released
+    bool take(Handle handle, T& out)
+    {
+        auto& shard = shards[ShardOf(handle)];
+
+        std::unique_lock lock(shard.mutex);
+        return shard.map.take(LocalHandle(handle), out);
+    }
+
+private:
+    static constexpr uint32_t ShardOf(Handle handle) { return Map::IndexOf(handle) % Shards; }
+    static constexpr Handle   LocalHandle(Handle handle)
+    {
+        return Map::MakeHandle(Map::IndexOf(handle) / Shards, Map::GenerationOf(handle));
+    }
+
+    struct alignas(64) Shard
+    {
+        std::shared_mutex mutex;
+        Map               map;
+    };
+
+    Shard                 shards[Shards];
+    std::atomic<uint32_t> next{0};
+};
@@ -37,3 +37,9 @@ bool IsPipedToString()
 {
     return coutbuf != nullptr;
 }
+
+std::recursive_mutex& StdOutLock()
+{
+    static std::recursive_mutex lock;
+    return lock;
+}
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <string>
+#include <mutex>
 
 void PipeToString();
 void DefaultStdOut();
@@ -9,3 +10,5 @@ std::string& GetBufferString();
 void SetStringBuffer(std::string& buf);
 bool IsPipedToString();
 void EraseBuffer();
+// Held by code that temporarily captures std::cout to parse its own output
+std::recursive_mutex& StdOutLock();
@@ -21,5 +21,8 @@ enum ErrorCodes
     EC_INVALID_JSON              = -12,
     EC_OPENDAQ_ERROR             = -13,
     EC_SIGNAL_IS_ALREADY_BOUND   = -14,
-    EC_UNBOUND_SIGNAL_READ_ATTEMPT = -15
+    EC_UNBOUND_SIGNAL_READ_ATTEMPT = -15,
+    EC_ACQUISITION_RUNNING       = -16,
+    EC_CONVERSION_FAILED         = -17,
+    EC_PROPERTY_READ_ONLY        = -18
 };
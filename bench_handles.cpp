@@ -0,0 +1,100 @@
+// Handle validation before and after the handle table: the createdPtrs set lib.cpp used to
+// check every pointer against (contains_uptr + dynamic_cast), and the ShardedSlotMap lookup
+// with its type tag, as Lookup/Cast do it. The plain SlotMap column is the same lookup
+// without the shard lock and the shared_ptr copy, the part thread safety costs. All of them
+// hold the same objects and are probed in the same order.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "BoilerplateImpl/OpenDaqObject.h"
+#include "BoilerplateImpl/slot_map.h"
+#include "BoilerplateImpl/util.h"
+
+class BenchObject : public OpenDaqObject
+{
+public:
+    static constexpr ObjectTag Tag = ObjectTag::Signal;
+
+    void help(int /*i*/) override {}
+};
+
+template <typename Probe>
+static double NanosecondsPerCall(size_t iterations, Probe&& probe)
+{
+    size_t found = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < iterations; ++i)
+        found += probe(i);
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    if(found != iterations)
+        std::printf("lookup failed %zu times\n", iterations - found);
+
+    return elapsed.count() / iterations;
+}
+
+static void Compare(size_t population, size_t iterations)
+{
+    std::unordered_set<OpenDaqObjectPtr> createdPtrs;
+    ShardedSlotMap<std::shared_ptr<OpenDaqObject>> handles;
+    SlotMap<std::shared_ptr<OpenDaqObject>> unlocked;
+
+    std::vector<OpenDaqObject*> pointers;
+    std::vector<uint64_t> ids;
+    std::vector<uint64_t> unlockedIds;
+
+    for(size_t i = 0; i < population; ++i) {
+        auto object = std::make_shared<BenchObject>();
+        object->tag = BenchObject::Tag;
+
+        // the set owns its copy, as it owned the wrappers it validated
+        pointers.push_back(createdPtrs.emplace(std::make_unique<BenchObject>()).first->get());
+        ids.push_back(handles.insert(object, static_cast<uint32_t>(BenchObject::Tag)));
+        unlockedIds.push_back(unlocked.insert(object, static_cast<uint32_t>(BenchObject::Tag)));
+    }
+
+    // same random probe order for both, so neither gets to walk memory sequentially
+    std::vector<uint32_t> order(population);
+    for(size_t i = 0; i < order.size(); ++i)
+        order[i] = static_cast<uint32_t>(i);
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+    const double before = NanosecondsPerCall(iterations, [&](size_t i)
+    {
+        OpenDaqObject* obj = pointers[order[i % order.size()]];
+        return contains_uptr(createdPtrs, obj) && dynamic_cast<BenchObject*>(obj) != nullptr;
+    });
+
+    const double after = NanosecondsPerCall(iterations, [&](size_t i)
+    {
+        std::shared_ptr<OpenDaqObject> value;
+        uint32_t tag = 0;
+        return handles.find(ids[order[i % order.size()]], value, tag) && tag == static_cast<uint32_t>(BenchObject::Tag);
+    });
+
+    const double table = NanosecondsPerCall(iterations, [&](size_t i)
+    {
+        const auto slot = unlocked.find(unlockedIds[order[i % order.size()]]);
+        return slot && slot->tag == static_cast<uint32_t>(BenchObject::Tag);
+    });
+
+    std::printf("%8zu objects: createdPtrs %6.2f ns, handle table %6.2f ns (%.2fx), plain SlotMap %6.2f ns\n",
+                population, before, after, before / after, table);
+}
+
+int main(int /*argc*/, const char* /*argv*/ [])
+{
+    const size_t iterations = 10000000;
+
+    for(size_t population : { 16, 1000, 100000 })
+        Compare(population, iterations);
+
+    return 0;
+}
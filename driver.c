@@ -12,181 +12,1928 @@ const char* modulename = "./libopendaq-bridge.so";
 #include <string.h>
 #include <stdint.h>
 #include <time.h>
+#include <math.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
 
 #include "ColoredPrinter.h"
 #include "ErrorCodes.h"
+#include "AbiTypes.h"
+
+#define UGLYCAST(x) (*(void **) (&x))
+
+#define GETFUN(x, handle) (UGLYCAST(x) = dlsym(handle, #x))
+
+typedef void* DaqObjectPtr;
+typedef void** DaqObjectPtrArray;
+
+
+char*		  (*LibraryInfo)		     (void);
+void 		  (*LibraryHelp) 			 (void);
+void          (*StdOut_PipeToString)     (void);
+const char*   (*StdOut_GetBufferString)  (void);
+void          (*StdOut_Default)          (void);
+void          (*StdOut_EraseBuffer)      (void);
+
+DaqObjectPtr (*Instance_New)         	 (void);
+void         (*OpenDaqObject_Free)       (DaqObjectPtr self);
+void         (*StringPool_Free)       	 (const char* str);
+
+int          (*OpenDaqObject_Print)   (DaqObjectPtr self, const char* item);
+int          (*OpenDaqObject_List)    (DaqObjectPtr self, const char* type);
+const char*  (*OpenDaqObject_Get)     (DaqObjectPtr self, const char* item);
+int          (*OpenDaqObject_GetToBuffer)(DaqObjectPtr self, const char* item, char* buf, uint64_t cap, uint64_t* needed);
+int          (*OpenDaqObject_GetCount)(DaqObjectPtr self, const char* itemArray);
+int          (*OpenDaqObject_Set)     (DaqObjectPtr self, const char* item, const char* value);
+int          (*OpenDaqObject_SetMany) (DaqObjectPtr self, const char** items, const char** values, uint64_t count);
+DaqObjectPtr (*OpenDaqObject_Select)  (DaqObjectPtr self, const char* type, uint64_t index);
+DaqObjectPtr (*OpenDaqObject_Resolve) (DaqObjectPtr root, const char* path);
+DaqObjectPtr (*OpenDaqObject_FindById)(DaqObjectPtr root, const char* globalId);
+void         (*OpenDaqObject_Help)    (DaqObjectPtr self);
+
+int          (*Property_GetDouble)    (DaqObjectPtr self, const char* name, double* out);
+int          (*Property_GetInt64)     (DaqObjectPtr self, const char* name, int64_t* out);
+int          (*Property_GetBool)      (DaqObjectPtr self, const char* name, int* out);
+int          (*Property_GetString)    (DaqObjectPtr self, const char* name, char* buf, uint64_t cap, uint64_t* needed);
+int          (*Property_SetDouble)    (DaqObjectPtr self, const char* name, double value);
+int          (*Property_SetInt64)     (DaqObjectPtr self, const char* name, int64_t value);
+int          (*Property_SetBool)      (DaqObjectPtr self, const char* name, int value);
+
+DaqObjectPtr (*Device_Add)              (DaqObjectPtr device, const char* type, const char* value);
+DaqObjectPtr (*Device_AddDevice)        (DaqObjectPtr device, const char* connectionString);
+DaqObjectPtr (*Device_AddFunctionBlock) (DaqObjectPtr device, const char* fbId);
+int          (*Device_Remove)           (DaqObjectPtr device, const char* type, uint64_t index);
+int          (*Device_RemoveDevice)     (DaqObjectPtr device, uint64_t index);
+int          (*Device_RemoveFunctionBlock)(DaqObjectPtr device, uint64_t index);
+
+const char*  (*Device_GetAvailableDeviceConnectionString)(DaqObjectPtr device, uint64_t index);
+const char*  (*Device_GetAvailableFunctionBlockID)(DaqObjectPtr device, uint64_t index);
+int          (*Device_GetAvailableDeviceConnectionStringToBuffer)(DaqObjectPtr device, uint64_t index, char* buf, uint64_t cap, uint64_t* needed);
+int          (*Device_GetAvailableFunctionBlockIDToBuffer)(DaqObjectPtr device, uint64_t index, char* buf, uint64_t cap, uint64_t* needed);
+
+int          (*Device_LoadConfiguration)(DaqObjectPtr device, const char* json);
+int          (*Device_LoadConfigurationFromFile)(DaqObjectPtr device, const char* json_path);
+const char*  (*Device_SaveConfiguration)(DaqObjectPtr device);
+int          (*Device_SaveConfigurationToBuffer)(DaqObjectPtr device, char* buf, uint64_t cap, uint64_t* needed);
+int          (*Device_SaveConfigurationToFile)(DaqObjectPtr device, const char* json_path);
+int          (*Device_Snapshot)(DaqObjectPtr device, unsigned int flags, char* buf, uint64_t cap, uint64_t* needed);
+
+int          (*InputPort_Connect)(DaqObjectPtr port, const char* signalid, DaqObjectPtr instance);
+int          (*InputPort_ConnectMany)(DaqObjectPtr* ports, const char** signalids, uint64_t count, DaqObjectPtr instance);
+int          (*InputPort_Disconnect)(DaqObjectPtr port);
+
+int          (*Signal_Read)(DaqObjectPtr signal, uint64_t NumOfSamples, int timeout);
+int          (*Signal_ReadInto)(DaqObjectPtr signal, double* values, int64_t* timestamps, uint64_t count, int timeout);
+int          (*Signal_SetReadFormat)(DaqObjectPtr signal, int sampleType, int raw);
+int          (*Signal_ReadTypedInto)(DaqObjectPtr signal, void* values, int64_t* timestamps, uint64_t count, int timeout);
+int          (*Signal_GetScaling)(DaqObjectPtr signal, double* scale, double* offset);
+int          (*Signal_ReadStats)(DaqObjectPtr signal, uint64_t count, int timeout, BlockStats* stats);
+int          (*Signal_ReadEnvelope)(DaqObjectPtr signal, uint64_t count, uint64_t bins, double* min, double* max,
+                                    double* first, double* last, int64_t* binTimes, int timeout);
+int          (*Signal_ReadTicksInto)(DaqObjectPtr signal, double* values, int64_t* ticks, uint64_t count, int timeout);
+int          (*Signal_GetDomainInfo)(DaqObjectPtr signal, TickDomain* info);
+int          (*Signal_TicksToTime)(DaqObjectPtr signal, const int64_t* ticks, int64_t* times, uint64_t count);
+int          (*Signal_ReadLinear)(DaqObjectPtr signal, double* values, uint64_t count, int timeout,
+                                  TimeAxis* axis, TimeBreak* breaks, uint64_t maxBreaks);
+int          (*Signal_StartAcquisition)(DaqObjectPtr signal, uint64_t ringCapacity);
+int          (*Signal_StopAcquisition)(DaqObjectPtr signal);
+int          (*Signal_Drain)(DaqObjectPtr signal, double* values, int64_t* timestamps, uint64_t max);
+int          (*Signal_GetAcquisitionStats)(DaqObjectPtr signal, uint64_t* available, uint64_t* highWater, uint64_t* overruns);
+int          (*Signal_SetReadTimeoutMode)(DaqObjectPtr signal, int mode);
+int          (*Signal_GetAvailableCount)(DaqObjectPtr signal, uint64_t* count);
+int          (*Signal_GetReadInfo)(DaqObjectPtr signal, ReadInfo* info);
+int          (*Signal_GetDimensions)(DaqObjectPtr signal, uint64_t* elements, double* labels, uint64_t cap);
+int          (*Signal_ReadVectors)(DaqObjectPtr signal, double* values, int64_t* timestamps, uint64_t count, int timeout);
+int          (*Signal_GetStructLayout)(DaqObjectPtr signal, StructField* fields, uint64_t cap, uint64_t* count, uint64_t* recordSize);
+int          (*Signal_ReadStructs)(DaqObjectPtr signal, void* records, int64_t* timestamps, uint64_t count, int timeout);
+int          (*Signal_BorrowStructs)(DaqObjectPtr signal, const void** records, int64_t* timestamps, uint64_t count, int timeout);
+int          (*Signal_ReleaseStructs)(DaqObjectPtr signal);
+typedef void (*DataCallback)(void* user, unsigned long long available);
+int          (*Signal_SetDataCallback)(DaqObjectPtr signal, DataCallback fn, void* user, uint64_t minSamples);
+
+double*      (*Signal_GetSampleReadings)(DaqObjectPtr signal);
+int64_t*     (*Signal_GetSampleTimeStamps)(DaqObjectPtr signal);
+
+int          (*Signal_GetSampleReadingsToArray)(DaqObjectPtr signal, double* array, uint64_t len);
+int          (*Signal_GetSampleTimeStampsToArray)(DaqObjectPtr signal, int64_t* array, uint64_t len);
+
+int          (*Signal_GetSampleCountOfRead)(DaqObjectPtr signal);
+int          (*Signal_EraseSamples)(DaqObjectPtr signal);
+const char*  (*TimeStampToString)(int64_t timestamp);
+
+int          (*Signal_SendDataPacket)(DaqObjectPtr signal, double* data, uint64_t count);
+int          (*Signal_SendTestDataPacket)(DaqObjectPtr signal, uint64_t count, double sine_range);
+
+int          (*Signal_LoadDataDescriptorFromJson)(DaqObjectPtr signal, const char* json);
+int          (*Signal_LoadDataDescriptorFromJsonFile)(DaqObjectPtr signal, const char* path);
+
+const char*  (*DataDescriptor_SaveToJson)(DaqObjectPtr signal);
+int          (*DataDescriptor_SaveToJsonFile)(DaqObjectPtr signal, const char* path);
+int          (*DataDescriptor_SaveToJsonToBuffer)(DaqObjectPtr signal, char* buf, uint64_t cap, uint64_t* needed);
+
+int 		 (*MultiReader_ReadToArrays)(int64_t multiReaderId,
+										 uint64_t NumOfSamples, int timeout,
+										 double** data, int64_t** timestamps);
+int          (*MultiReader_SetReadFormat)(int64_t multiReaderId, int sampleType, int raw);
+int          (*MultiReader_ReadTypedToArrays)(int64_t multiReaderId, uint64_t NumOfSamples, int timeout,
+											  void** data, int64_t** timestamps);
+int          (*MultiReader_ReadShared)(int64_t multiReaderId, uint64_t NumOfSamples, int timeout,
+										 double** data, int64_t* timestamps);
+int          (*MultiReader_ReadToBuffer)(int64_t multiReaderId, uint64_t NumOfSamples, int timeout,
+										 int layout, uint64_t stride, double* data, int64_t* timestamps);
+int          (*MultiReader_ReadStats)(int64_t multiReaderId, uint64_t NumOfSamples, int timeout, BlockStats* stats);
+int          (*MultiReader_ReadEnvelope)(int64_t multiReaderId, uint64_t NumOfSamples, uint64_t bins, int timeout,
+                                         double** min, double** max, double** first, double** last, int64_t* binTimes);
+int          (*MultiReader_ReadLinear)(int64_t multiReaderId, uint64_t NumOfSamples, int timeout,
+                                       double** data, TimeAxis* axis, TimeBreak* breaks, uint64_t maxBreaks);
+
+int64_t      (*MultiReader_Bind)(DaqObjectPtrArray signals, uint64_t NumOfSignals);
+int64_t      (*MultiReader_BindTicks)(DaqObjectPtrArray signals, uint64_t NumOfSignals);
+int          (*MultiReader_UnBind)(int64_t multiReaderId);
+int          (*MultiReader_SetReadTimeoutMode)(int64_t multiReaderId, int mode);
+int          (*MultiReader_GetAvailableCount)(int64_t multiReaderId, uint64_t* count);
+int          (*MultiReader_GetReadInfo)(int64_t multiReaderId, ReadInfo* info);
+int          (*MultiReader_SetDataCallback)(int64_t multiReaderId, DataCallback fn, void* user, uint64_t minSamples);
+
+
+void InitFunctions(void* handle)
+{
+
+	GETFUN(LibraryHelp, handle);
+	GETFUN(LibraryInfo, handle);
+	GETFUN(StdOut_Default, handle);
+	GETFUN(StdOut_GetBufferString, handle);
+	GETFUN(StdOut_PipeToString, handle);
+	GETFUN(StdOut_EraseBuffer, handle);
+
+	GETFUN(Instance_New, handle);
+	GETFUN(OpenDaqObject_Free, handle);
+	GETFUN(StringPool_Free, handle);
+
+	GETFUN(OpenDaqObject_Print, handle);
+	GETFUN(OpenDaqObject_List, handle);
+	GETFUN(OpenDaqObject_Get, handle);
+	GETFUN(OpenDaqObject_GetToBuffer, handle);
+	GETFUN(OpenDaqObject_GetCount, handle);
+	GETFUN(OpenDaqObject_Set, handle);
+	GETFUN(OpenDaqObject_SetMany, handle);
+	GETFUN(OpenDaqObject_Select, handle);
+	GETFUN(OpenDaqObject_Resolve, handle);
+	GETFUN(OpenDaqObject_FindById, handle);
+	GETFUN(OpenDaqObject_Help, handle);
+
+	GETFUN(Property_GetDouble, handle);
+	GETFUN(Property_GetInt64, handle);
+	GETFUN(Property_GetBool, handle);
+	GETFUN(Property_GetString, handle);
+	GETFUN(Property_SetDouble, handle);
+	GETFUN(Property_SetInt64, handle);
+	GETFUN(Property_SetBool, handle);
+
+	GETFUN(Device_Add, handle);
+	GETFUN(Device_AddDevice, handle);
+	GETFUN(Device_AddFunctionBlock, handle);
+	GETFUN(Device_Remove, handle);
+	GETFUN(Device_RemoveDevice, handle);
+	GETFUN(Device_RemoveFunctionBlock, handle);
+
+	GETFUN(Device_GetAvailableDeviceConnectionString, handle);
+	GETFUN(Device_GetAvailableFunctionBlockID, handle);
+	GETFUN(Device_GetAvailableDeviceConnectionStringToBuffer, handle);
+	GETFUN(Device_GetAvailableFunctionBlockIDToBuffer, handle);
+
+	GETFUN(Device_LoadConfiguration, handle);
+	GETFUN(Device_LoadConfigurationFromFile, handle);
+	GETFUN(Device_SaveConfiguration, handle);
+	GETFUN(Device_SaveConfigurationToBuffer, handle);
+	GETFUN(Device_SaveConfigurationToFile, handle);
+	GETFUN(Device_Snapshot, handle);
+
+	GETFUN(InputPort_Connect, handle);
+	GETFUN(InputPort_ConnectMany, handle);
+	GETFUN(InputPort_Disconnect, handle);
+
+	GETFUN(Signal_Read, handle);
+	GETFUN(Signal_ReadInto, handle);
+	GETFUN(Signal_SetReadFormat, handle);
+	GETFUN(Signal_ReadTypedInto, handle);
+	GETFUN(Signal_GetScaling, handle);
+	GETFUN(Signal_ReadStats, handle);
+	GETFUN(Signal_ReadEnvelope, handle);
+	GETFUN(Signal_ReadTicksInto, handle);
+	GETFUN(Signal_GetDomainInfo, handle);
+	GETFUN(Signal_TicksToTime, handle);
+	GETFUN(Signal_ReadLinear, handle);
+	GETFUN(Signal_StartAcquisition, handle);
+	GETFUN(Signal_StopAcquisition, handle);
+	GETFUN(Signal_Drain, handle);
+	GETFUN(Signal_GetAcquisitionStats, handle);
+	GETFUN(Signal_SetReadTimeoutMode, handle);
+	GETFUN(Signal_GetAvailableCount, handle);
+	GETFUN(Signal_GetReadInfo, handle);
+	GETFUN(Signal_GetDimensions, handle);
+	GETFUN(Signal_ReadVectors, handle);
+	GETFUN(Signal_GetStructLayout, handle);
+	GETFUN(Signal_ReadStructs, handle);
+	GETFUN(Signal_BorrowStructs, handle);
+	GETFUN(Signal_ReleaseStructs, handle);
+	GETFUN(Signal_SetDataCallback, handle);
+	GETFUN(Signal_GetSampleReadings, handle);
+	GETFUN(Signal_GetSampleTimeStamps, handle);
+	GETFUN(Signal_GetSampleReadingsToArray, handle);
+	GETFUN(Signal_GetSampleTimeStampsToArray, handle);
+	GETFUN(Signal_GetSampleCountOfRead, handle);
+	GETFUN(Signal_EraseSamples, handle);
+
+	GETFUN(Signal_SendDataPacket, handle);
+	GETFUN(Signal_SendTestDataPacket, handle);
+
+	GETFUN(Signal_LoadDataDescriptorFromJson, handle);
+	GETFUN(Signal_LoadDataDescriptorFromJsonFile, handle);
+
+	GETFUN(DataDescriptor_SaveToJson, handle);
+	GETFUN(DataDescriptor_SaveToJsonFile, handle);
+	GETFUN(DataDescriptor_SaveToJsonToBuffer, handle);
+
+	GETFUN(TimeStampToString, handle);
+	GETFUN(MultiReader_ReadToArrays, handle);
+	GETFUN(MultiReader_SetReadFormat, handle);
+	GETFUN(MultiReader_ReadTypedToArrays, handle);
+	GETFUN(MultiReader_ReadShared, handle);
+	GETFUN(MultiReader_ReadToBuffer, handle);
+	GETFUN(MultiReader_ReadStats, handle);
+	GETFUN(MultiReader_ReadEnvelope, handle);
+	GETFUN(MultiReader_ReadLinear, handle);
+	GETFUN(MultiReader_Bind, handle);
+	GETFUN(MultiReader_BindTicks, handle);
+	GETFUN(MultiReader_UnBind, handle);
+	GETFUN(MultiReader_SetReadTimeoutMode, handle);
+	GETFUN(MultiReader_GetAvailableCount, handle);
+	GETFUN(MultiReader_GetReadInfo, handle);
+	GETFUN(MultiReader_SetDataCallback, handle);
+}
+
+void SaveToCSV(const char* path, double* values, int size)
+{
+	FILE* f = fopen(path, "w");
+	if(!f) return;
+
+	for(int i = 0; i < size-1; ++i) {
+		fprintf(f, "%f,", values[i]);
+	}
+
+	fprintf(f, "%f\n", values[size-1]);
+}
+
+
+void Test_CheckStdOutRedirect()
+{
+	StdOut_PipeToString();
+	LibraryHelp();
+	const char* str = StdOut_GetBufferString();
+	StdOut_Default();
+	printf("%s", str);
+	const char* str2 = LibraryInfo();
+	assert(str);
+	assert(str2);
+
+	puts(str);
+	puts(str2);
+
+	StdOut_EraseBuffer();
+
+	Success();
+	puts("Test_CheckStdOutRedirect: Success\n");
+	ResetColors();
+}
+
+
+static double NowSeconds(void)
+{
+#ifdef _WIN32
+	return (double)clock() / CLOCKS_PER_SEC; // wall time on MSVC
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static void SleepMs(int ms)
+{
+#ifdef _WIN32
+	Sleep(ms);
+#else
+	struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+	nanosleep(&ts, NULL);
+#endif
+}
+
+// Instance with a reference device of channels channels, each channel's first signal resolved.
+// Shared by the tests below; rate may be NULL and channels 0 to keep the device defaults
+#define FIXTURE_MAX_SIGNALS 4
+
+typedef struct Fixture
+{
+	DaqObjectPtr instance;
+	DaqObjectPtr dev;
+	DaqObjectPtr signals[FIXTURE_MAX_SIGNALS];
+	int channels;
+} Fixture;
+
+static void Fixture_Setup(Fixture* fixture, int channels, const char* rate)
+{
+	assert(channels >= 0 && channels <= FIXTURE_MAX_SIGNALS);
+
+	fixture->instance = Instance_New();
+	assert(fixture->instance);
+
+	const char* connectionString = Device_GetAvailableDeviceConnectionString(fixture->instance, 0);
+	assert(connectionString);
+
+	fixture->dev = Device_AddDevice(fixture->instance, connectionString);
+	assert(fixture->dev);
+	StringPool_Free(connectionString);
+
+	if(channels) {
+		char count[16];
+		snprintf(count, sizeof(count), "%d", channels);
+		OpenDaqObject_Set(fixture->dev, "NumberOfChannels", count);
+	}
+	if(rate)
+		OpenDaqObject_Set(fixture->dev, "GlobalSampleRate", rate);
+
+	fixture->channels = channels;
+	for(int i = 0; i < channels; ++i) {
+		char path[64];
+		snprintf(path, sizeof(path), "channel/%d/signal/0", i);
+		fixture->signals[i] = OpenDaqObject_Resolve(fixture->dev, path);
+		assert(fixture->signals[i]);
+	}
+}
+
+static void Fixture_Teardown(Fixture* fixture)
+{
+	for(int i = 0; i < fixture->channels; ++i)
+		OpenDaqObject_Free(fixture->signals[i]);
+	OpenDaqObject_Free(fixture->dev);
+	OpenDaqObject_Free(fixture->instance);
+}
+
+void Test_HandleValidation()
+{
+	DaqObjectPtr instance = Instance_New();
+	assert(instance);
+
+	do {
+		PrintInfo("Checking Stale And Foreign Handles");
+
+		DaqObjectPtr sync = OpenDaqObject_Select(instance, "sync", 0);
+		assert(sync);
+		assert(OpenDaqObject_GetCount(sync, "properties") != EC_INVALID_POINTER);
+
+		// selecting the same component again hands out the same, refcounted handle
+		DaqObjectPtr again = OpenDaqObject_Select(instance, "sync", 0);
+		assert(again == sync);
+		OpenDaqObject_Free(again);
+		assert(OpenDaqObject_GetCount(sync, "properties") != EC_INVALID_POINTER);
+
+		OpenDaqObject_Free(sync);
+		assert(OpenDaqObject_GetCount(sync, "properties") == EC_INVALID_POINTER);
+
+		// a freed slot gets reused with a new generation
+		DaqObjectPtr sync2 = OpenDaqObject_Select(instance, "sync", 0);
+		assert(sync2 && sync2 != sync);
+		assert(OpenDaqObject_GetCount(sync, "properties") == EC_INVALID_POINTER);
+		OpenDaqObject_Free(sync2);
+
+		assert(OpenDaqObject_GetCount((DaqObjectPtr)0x1234, "properties") == EC_INVALID_POINTER);
+		assert(Signal_GetSampleCountOfRead(instance) == EC_OBJECT_TYPE_MISMATCH);
+	} while(0);
+
+	do {
+		PrintInfo("Removing A Component Releases Its Handle");
+
+		DaqObjectPtr fb = Device_AddFunctionBlock(instance, "RefFBModuleStatistics");
+		assert(fb);
+		assert(OpenDaqObject_GetCount(fb, "properties") != EC_INVALID_POINTER);
+
+		DaqObjectPtr port = OpenDaqObject_Select(fb, "input-port", 0);
+		assert(port);
+
+		// nothing to remove, nothing released
+		assert(Device_RemoveFunctionBlock(instance, 1) == EC_ARRAY_OUT_OF_BOUNDS);
+		assert(OpenDaqObject_GetCount(fb, "properties") != EC_INVALID_POINTER);
+
+		assert(Device_RemoveFunctionBlock(instance, 0) == EC_OK);
+		assert(OpenDaqObject_GetCount(fb, "properties") == EC_INVALID_POINTER);
+		assert(OpenDaqObject_GetCount(port, "properties") == EC_INVALID_POINTER);
+
+		// freeing the released handles is harmless
+		OpenDaqObject_Free(port);
+		OpenDaqObject_Free(fb);
+	} while(0);
+
+	OpenDaqObject_Free(instance);
+
+	Success();
+	puts("Test_HandleValidation: Success\n");
+	ResetColors();
+}
+
+// Measures validation + type check only: a device passed to a signal method is
+// rejected before any openDAQ call is made. bench-handles compares the lookup itself
+// with the createdPtrs set it replaced
+void Bench_HandleValidation()
+{
+	const int iterations = 10000000;
+
+	DaqObjectPtr instance = Instance_New();
+	assert(instance);
+
+	double start = NowSeconds();
+	for(int i = 0; i < iterations; ++i)
+		Signal_GetSampleCountOfRead(instance);
+	double elapsed = NowSeconds() - start;
+
+	Info();
+	printf("Bench_HandleValidation: %.2f ns/call\n", elapsed * 1e9 / iterations);
+	ResetColors();
+
+	OpenDaqObject_Free(instance);
+}
+
+// Portable threads for the stress tests, pthreads or Win32 underneath
+#ifdef _WIN32
+typedef struct
+{
+	void* (*fn)(void*);
+	void*  arg;
+	HANDLE handle;
+} Thread;
+
+static DWORD WINAPI ThreadTrampoline(LPVOID param)
+{
+	Thread* thread = param;
+	thread->fn(thread->arg);
+	return 0;
+}
+
+static void Thread_Start(Thread* thread, void* (*fn)(void*), void* arg)
+{
+	thread->fn = fn;
+	thread->arg = arg;
+	thread->handle = CreateThread(NULL, 0, ThreadTrampoline, thread, 0, NULL);
+	assert(thread->handle);
+}
+
+static void Thread_Join(Thread* thread)
+{
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+}
+
+static int ProcessorCount(void)
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int)info.dwNumberOfProcessors;
+}
+#else
+typedef struct
+{
+	pthread_t handle;
+} Thread;
+
+static void Thread_Start(Thread* thread, void* (*fn)(void*), void* arg)
+{
+	const int started = pthread_create(&thread->handle, NULL, fn, arg);
+	assert(started == 0);
+	(void)started;
+}
+
+static void Thread_Join(Thread* thread)
+{
+	pthread_join(thread->handle, NULL);
+}
+
+static int ProcessorCount(void)
+{
+	return (int)sysconf(_SC_NPROCESSORS_ONLN);
+}
+#endif
+
+#define STRESS_CHANNELS 4
+#define STRESS_RATE 250000
+#define STRESS_RATE_STR "250000"
+#define STRESS_BACKLOG_MS 2000
+#define STRESS_BLOCK 10000
+
+typedef struct
+{
+	DaqObjectPtr  signal;
+	DaqObjectPtr  device;
+	double*       values;
+	int64_t*      timestamps;
+	long          calls;
+	long          samples;
+	volatile int* stop;
+} StressWorker;
+
+// Drains the backlog of its signal in blocks until it has caught up with the device
+static void* ReadWorkerMain(void* arg)
+{
+	StressWorker* worker = arg;
+	int count;
+
+	do {
+		count = Signal_ReadInto(worker->signal, worker->values, worker->timestamps, STRESS_BLOCK, 0);
+		assert(count >= 0);
+
+		worker->samples += count;
+		worker->calls++;
+	} while(count == STRESS_BLOCK);
+
+	return NULL;
+}
+
+// Churns the handle table and the string pool while the readers run
+static void* SelectWorkerMain(void* arg)
+{
+	StressWorker* worker = arg;
+
+	while(!*worker->stop) {
+		DaqObjectPtr channel = OpenDaqObject_Select(worker->device, "channel", worker->calls % STRESS_CHANNELS);
+		assert(channel);
+
+		const char* name = OpenDaqObject_Get(channel, "name");
+		StringPool_Free(name);
+
+		OpenDaqObject_Free(channel);
+		worker->calls++;
+	}
+	return NULL;
+}
+
+// Lets every worker's signal queue a backlog, drains them in parallel and returns the
+// samples per second read by all of them together
+static double RunReaders(StressWorker* workers, int count, DaqObjectPtr churnDevice)
+{
+	Thread threads[STRESS_CHANNELS + 1];
+	volatile int stop = 0;
+	StressWorker churn = { NULL, churnDevice, NULL, NULL, 0, 0, &stop };
+	long total = 0;
+
+	// the first read creates the reader, the backlog builds up from there
+	for(int i = 0; i < count; ++i) {
+		workers[i].calls = workers[i].samples = 0;
+		while(Signal_ReadInto(workers[i].signal, workers[i].values, workers[i].timestamps, STRESS_BLOCK, 0) == STRESS_BLOCK);
+	}
+	SleepMs(STRESS_BACKLOG_MS);
+
+	if(churnDevice)
+		Thread_Start(&threads[count], SelectWorkerMain, &churn);
+
+	double start = NowSeconds();
+	for(int i = 0; i < count; ++i)
+		Thread_Start(&threads[i], ReadWorkerMain, &workers[i]);
+
+	for(int i = 0; i < count; ++i) {
+		Thread_Join(&threads[i]);
+		total += workers[i].samples;
+	}
+	double elapsed = NowSeconds() - start;
+
+	stop = 1;
+	if(churnDevice)
+		Thread_Join(&threads[count]);
+
+	// none of the readers may be starved by the others or by the churn
+	for(int i = 0; i < count; ++i)
+		assert(workers[i].samples >= (long)STRESS_RATE * STRESS_BACKLOG_MS / 1000 / 2);
+
+	return total / elapsed;
+}
+
+void Test_ConcurrentReads()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, STRESS_CHANNELS, STRESS_RATE_STR);
+
+	StressWorker workers[STRESS_CHANNELS];
+
+	for(int i = 0; i < STRESS_CHANNELS; ++i) {
+		workers[i].signal = fixture.signals[i];
+		workers[i].device = fixture.dev;
+		workers[i].values = malloc(STRESS_BLOCK * sizeof(double));
+		workers[i].timestamps = malloc(STRESS_BLOCK * sizeof(int64_t));
+		workers[i].stop = NULL;
+	}
+
+	do {
+		PrintInfo("Draining One Signal's Backlog From One Thread");
+
+		double single = RunReaders(workers, 1, NULL);
+
+		PrintInfo("Draining Every Signal's Backlog From Its Own Thread While Selecting");
+
+		double parallel = RunReaders(workers, STRESS_CHANNELS, fixture.dev);
+		double scaling = parallel / single;
+
+		Info();
+		printf("Single thread: %.0f samples/s, %d threads: %.0f samples/s, scaling %.2fx\n",
+			   single, STRESS_CHANNELS, parallel, scaling);
+		ResetColors();
+
+		// reads on different signals only share the handle shards, so they must scale
+		// wherever there are cores for them
+		if(ProcessorCount() >= STRESS_CHANNELS + 1)
+			assert(scaling > 1.5);
+	} while(0);
+
+	for(int i = 0; i < STRESS_CHANNELS; ++i) {
+		free(workers[i].values);
+		free(workers[i].timestamps);
+	}
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_ConcurrentReads: Success\n");
+	ResetColors();
+}
+
+void Test_StringBuffers()
+{
+	DaqObjectPtr instance = Instance_New();
+	assert(instance);
+
+	do {
+		PrintInfo("Saving Configuration To Caller Buffer");
+
+		uint64_t needed = 0;
+		assert(Device_SaveConfigurationToBuffer(instance, NULL, 0, &needed) == EC_INSUFFICIENT_SIZE);
+		assert(needed > 1);
+
+		char* config = malloc(needed);
+		assert(Device_SaveConfigurationToBuffer(instance, config, needed, &needed) == EC_OK);
+		assert(strlen(config) + 1 == needed);
+		free(config);
+	} while(0);
+
+	do {
+		PrintInfo("Freeing Equal Pooled Strings Independently");
+
+		const char* first = Device_GetAvailableFunctionBlockID(instance, 0);
+		const char* second = Device_GetAvailableFunctionBlockID(instance, 0);
+		assert(first && second && first != second);
+
+		StringPool_Free(first);
+		assert(strlen(second) > 0);
+
+		char id[256];
+		uint64_t needed = 0;
+		assert(Device_GetAvailableFunctionBlockIDToBuffer(instance, 0, id, sizeof(id), &needed) == EC_OK);
+		assert(strcmp(id, second) == 0);
+
+		StringPool_Free(second);
+	} while(0);
+
+	OpenDaqObject_Free(instance);
+
+	Success();
+	puts("Test_StringBuffers: Success\n");
+	ResetColors();
+}
+
+// Compares the stdout capture path of OpenDaqObject_Get with the typed getter
+void Bench_PropertyGet()
+{
+	const int iterations = 10000;
+
+	Fixture fixture;
+	Fixture_Setup(&fixture, 0, "1000");
+
+	double rate = 0;
+	int64_t channels = 0;
+	assert(Property_GetDouble(fixture.dev, "GlobalSampleRate", &rate) == EC_OK);
+	assert(rate == 1000);
+	assert(Property_GetInt64(fixture.dev, "NumberOfChannels", &channels) == EC_OK);
+	assert(Property_GetDouble(fixture.dev, "NoSuchProperty", &rate) == EC_PROPERTY_DOESNT_EXIST);
+	assert(Property_GetDouble(fixture.dev, "GlobalSampleRate", NULL) == EC_INVALID_POINTER);
+	assert(Property_GetInt64(fixture.dev, NULL, &channels) == EC_INVALID_POINTER);
+	assert(Property_SetDouble(fixture.dev, NULL, 1000) == EC_INVALID_POINTER);
+
+	double start = NowSeconds();
+	for(int i = 0; i < iterations; ++i)
+		StringPool_Free(OpenDaqObject_Get(fixture.dev, "GlobalSampleRate"));
+	double textual = NowSeconds() - start;
+
+	start = NowSeconds();
+	for(int i = 0; i < iterations; ++i)
+		Property_GetDouble(fixture.dev, "GlobalSampleRate", &rate);
+	double typed = NowSeconds() - start;
+
+	Info();
+	printf("Bench_PropertyGet: OpenDaqObject_Get %.0f ns/call, Property_GetDouble %.0f ns/call\n",
+		   textual * 1e9 / iterations, typed * 1e9 / iterations);
+	ResetColors();
+
+	do {
+		PrintInfo("Setting Typed And Batched Properties");
+
+		assert(Property_SetDouble(fixture.dev, "GlobalSampleRate", 2000) == EC_OK);
+		assert(Property_GetDouble(fixture.dev, "GlobalSampleRate", &rate) == EC_OK && rate == 2000);
+
+		int64_t before = 0;
+		assert(Property_GetInt64(fixture.dev, "NumberOfChannels", &before) == EC_OK);
+		assert(Property_SetDouble(fixture.dev, "NumberOfChannels", 2.7) == EC_CONVERSION_FAILED);
+		assert(Property_SetDouble(fixture.dev, "NumberOfChannels", 1e300) == EC_CONVERSION_FAILED);
+		assert(Property_SetDouble(fixture.dev, "NumberOfChannels", NAN) == EC_CONVERSION_FAILED);
+		assert(Property_GetInt64(fixture.dev, "NumberOfChannels", &channels) == EC_OK && channels == before);
+
+		const char* names[]  = { "NumberOfChannels", "GlobalSampleRate", "AcquisitionLoopTime" };
+		const char* values[] = { "2", "1000", "10" };
+		assert(OpenDaqObject_SetMany(fixture.dev, names, values, 3) == EC_OK);
+
+		const char* unset[] = { "NumberOfChannels", NULL };
+		const char* invalid[] = { "GlobalSampleRate", "1000 +" };
+		assert(OpenDaqObject_SetMany(fixture.dev, NULL, values, 3) == EC_INVALID_POINTER);
+		assert(OpenDaqObject_SetMany(fixture.dev, names, unset, 2) == EC_INVALID_POINTER);
+		assert(OpenDaqObject_SetMany(fixture.dev, invalid, invalid + 1, 1) == EC_CONVERSION_FAILED);
+
+		assert(Property_GetInt64(fixture.dev, "NumberOfChannels", &channels) == EC_OK && channels == 2);
+		assert(Property_GetDouble(fixture.dev, "GlobalSampleRate", &rate) == EC_OK && rate == 1000);
+	} while(0);
+
+	Fixture_Teardown(&fixture);
+}
+
+void Test_ResolvePath()
+{
+	const int iterations = 10000;
+
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, NULL);
+
+	do {
+		PrintInfo("Resolving Paths And Global IDs");
+
+		assert(OpenDaqObject_GetCount(fixture.dev, "channels") == 2);
+
+		DaqObjectPtr channel = OpenDaqObject_Select(fixture.dev, "channel", 1);
+		DaqObjectPtr signal = OpenDaqObject_Select(channel, "signal", 0);
+		assert(signal);
+
+		DaqObjectPtr resolved = OpenDaqObject_Resolve(fixture.instance, "/dev/0/channel/1/signal/0");
+		assert(resolved == signal);
+		OpenDaqObject_Free(resolved);
+
+		// cached the second time around, the index defaults to 0
+		resolved = OpenDaqObject_Resolve(fixture.instance, "device/0/channel/1/signal");
+		assert(resolved == signal);
+		OpenDaqObject_Free(resolved);
+
+		char id[256];
+		assert(OpenDaqObject_GetToBuffer(signal, "id", id, sizeof(id), NULL) == EC_OK);
+
+		resolved = OpenDaqObject_FindById(fixture.instance, id);
+		assert(resolved == signal);
+		OpenDaqObject_Free(resolved);
+
+		assert(!OpenDaqObject_Resolve(fixture.instance, "dev/0/channel/7/signal/0"));
+		assert(!OpenDaqObject_FindById(fixture.instance, "/no/such/component"));
+
+		double start = NowSeconds();
+		for(int i = 0; i < iterations; ++i) {
+			DaqObjectPtr ch = OpenDaqObject_Select(fixture.dev, "channel", 1);
+			OpenDaqObject_Free(OpenDaqObject_Select(ch, "signal", 0));
+			OpenDaqObject_Free(ch);
+		}
+		double selected = NowSeconds() - start;
+
+		start = NowSeconds();
+		for(int i = 0; i < iterations; ++i)
+			OpenDaqObject_Free(OpenDaqObject_Resolve(fixture.instance, "dev/0/channel/1/signal/0"));
+		double cached = NowSeconds() - start;
+
+		Info();
+		printf("Test_ResolvePath: Select chain %.0f ns, Resolve %.0f ns\n",
+			   selected * 1e9 / iterations, cached * 1e9 / iterations);
+		ResetColors();
+
+		OpenDaqObject_Free(signal);
+		OpenDaqObject_Free(channel);
+
+		// removing channels invalidates the cached path and child lists
+		OpenDaqObject_Set(fixture.dev, "NumberOfChannels", "1");
+		assert(!OpenDaqObject_Resolve(fixture.instance, "dev/0/channel/1/signal/0"));
+		assert(OpenDaqObject_GetCount(fixture.dev, "channels") == 1);
+		assert(!OpenDaqObject_Select(fixture.dev, "channel", 1));
+	} while(0);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_ResolvePath: Success\n");
+	ResetColors();
+}
+
+void Test_Snapshot()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, NULL);
+
+	do {
+		PrintInfo("Taking A Device Snapshot");
+
+		uint64_t needed = 0;
+		assert(Device_Snapshot(fixture.instance, SNAPSHOT_ALL, NULL, 0, &needed) == EC_INSUFFICIENT_SIZE);
+		assert(needed > 1);
+
+		char* json = malloc(needed);
+		assert(Device_Snapshot(fixture.instance, SNAPSHOT_ALL, json, needed, &needed) == EC_OK);
+		assert(json[0] == '{');
+		assert(strstr(json, "\"GlobalSampleRate\""));
+		assert(strstr(json, "\"sampleRate\""));
+
+		char id[256];
+		DaqObjectPtr signal = OpenDaqObject_Resolve(fixture.dev, "channel/1/signal/0");
+		assert(OpenDaqObject_GetToBuffer(signal, "id", id, sizeof(id), NULL) == EC_OK);
+		assert(strstr(json, id));
+		OpenDaqObject_Free(signal);
+
+		Info();
+		printf("Test_Snapshot: %llu bytes\n", (unsigned long long)needed);
+		ResetColors();
+
+		free(json);
+
+		assert(Device_Snapshot(signal, SNAPSHOT_ALL, NULL, 0, &needed) == EC_INVALID_POINTER);
+	} while(0);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_Snapshot: Success\n");
+	ResetColors();
+}
+
+#define BENCH_RATE_STR "1000000"
+#define BENCH_BLOCK 10000
+#define BENCH_BACKLOG_MS 200
+
+// Lets a backlog build up, then drains it with timeout 0, so only the read path is timed
+static double DrainBacklog(DaqObjectPtr signal, int into, double* values, int64_t* timestamps, long* drained)
+{
+	SleepMs(BENCH_BACKLOG_MS);
+
+	double start = NowSeconds();
+	int count;
+	*drained = 0;
+
+	do {
+		if(into) {
+			count = Signal_ReadInto(signal, values, timestamps, BENCH_BLOCK, 0);
+		} else {
+			count = Signal_Read(signal, BENCH_BLOCK, 0);
+			Signal_GetSampleReadingsToArray(signal, values, count);
+			Signal_GetSampleTimeStampsToArray(signal, timestamps, count);
+		}
+		*drained += count;
+	} while(count == BENCH_BLOCK);
+
+	return NowSeconds() - start;
+}
+
+void Bench_SignalReadInto()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 1, BENCH_RATE_STR);
+
+	double* values = malloc(BENCH_BLOCK * sizeof(double));
+	int64_t* timestamps = malloc(BENCH_BLOCK * sizeof(int64_t));
+
+	do {
+		PrintInfo("Reading At 1 MS/s: Read + GetToArray vs ReadInto");
+
+		// creates the reader and discards what was queued before
+		Signal_ReadInto(fixture.signals[0], values, timestamps, BENCH_BLOCK, 0);
+		while(Signal_ReadInto(fixture.signals[0], values, timestamps, BENCH_BLOCK, 0) == BENCH_BLOCK);
+
+		long copied, direct;
+		double copiedTime = DrainBacklog(fixture.signals[0], 0, values, timestamps, &copied);
+		double directTime = DrainBacklog(fixture.signals[0], 1, values, timestamps, &direct);
+
+		assert(copied > 0 && direct > 0);
+		assert(Signal_ReadInto(fixture.dev, values, timestamps, 1, 0) == EC_OBJECT_TYPE_MISMATCH);
+
+		Info();
+		printf("Bench_SignalReadInto: Read + GetToArray %.2f ns/sample, ReadInto %.2f ns/sample\n",
+			   copiedTime * 1e9 / copied, directTime * 1e9 / direct);
+		ResetColors();
+	} while(0);
+
+	free(values);
+	free(timestamps);
+
+	Fixture_Teardown(&fixture);
+}
+
+void Test_TypedReads()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, NULL);
+
+	do {
+		PrintInfo("Reading Native, Float32 And Raw Samples");
+
+		float values[100];
+		int64_t timestamps[100];
+
+		// the reference channel produces doubles
+		assert(Signal_SetReadFormat(fixture.signals[0], SAMPLE_TYPE_NATIVE, 0) == SAMPLE_TYPE_FLOAT64);
+		assert(Signal_SetReadFormat(fixture.signals[0], SAMPLE_TYPE_FLOAT32, 0) == SAMPLE_TYPE_FLOAT32);
+		assert(Signal_ReadTypedInto(fixture.signals[0], values, timestamps, 100, 1000) == 100);
+
+		double scale, offset;
+		int scaling = Signal_GetScaling(fixture.signals[0], &scale, &offset);
+		assert(scaling == EC_OK || (scaling == EC_NOT_AVAILABLE && scale == 1 && offset == 0));
+
+		int raw = Signal_SetReadFormat(fixture.signals[0], SAMPLE_TYPE_NATIVE, 1);
+		assert(raw > 0);
+
+		assert(Signal_SetReadFormat(fixture.signals[0], 15, 0) == EC_OBJECT_TYPE_MISMATCH);
+	} while(0);
+
+	do {
+		PrintInfo("Reading Float32 From A Multi Reader");
+
+		DaqObjectPtr signals[2] = { fixture.signals[0], fixture.signals[1] };
+		float values[2][100];
+		int64_t timestamps[2][100];
+		void* data[2] = { values[0], values[1] };
+		int64_t* times[2] = { timestamps[0], timestamps[1] };
+		double* doubles[2] = { NULL, NULL };
+
+		int64_t multireaderId = MultiReader_Bind(signals, 2);
+		assert(multireaderId > 0);
+
+		assert(MultiReader_SetReadFormat(multireaderId, SAMPLE_TYPE_NATIVE, 0) == SAMPLE_TYPE_FLOAT64);
+		assert(MultiReader_SetReadFormat(multireaderId, SAMPLE_TYPE_FLOAT32, 0) == SAMPLE_TYPE_FLOAT32);
+		assert(MultiReader_ReadTypedToArrays(multireaderId, 100, 1000, data, times) == 100);
+		assert(timestamps[0][99] == timestamps[1][99]);
+
+		// the double reads refuse to write floats into double arrays
+		assert(MultiReader_ReadToArrays(multireaderId, 100, 1000, doubles, times) == EC_OBJECT_TYPE_MISMATCH);
+		assert(MultiReader_SetReadFormat(multireaderId, 15, 0) == EC_OBJECT_TYPE_MISMATCH);
+
+		MultiReader_UnBind(multireaderId);
+	} while(0);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_TypedReads: Success\n");
+	ResetColors();
+}
+
+void Test_Acquisition()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 1, "10000");
+
+	double* values = malloc(BENCH_BLOCK * sizeof(double));
+	int64_t* timestamps = malloc(BENCH_BLOCK * sizeof(int64_t));
+
+	do {
+		PrintInfo("Acquiring In The Background");
+
+		assert(Signal_Drain(fixture.signals[0], values, timestamps, BENCH_BLOCK) == EC_UNINITIALIZED);
+		assert(Signal_StartAcquisition(fixture.signals[0], 0) == EC_ARRAY_OUT_OF_BOUNDS);
+		assert(Signal_StartAcquisition(fixture.signals[0], ~0ull) == EC_ARRAY_OUT_OF_BOUNDS);
+		assert(Signal_StartAcquisition(fixture.signals[0], 1000) == EC_OK);
+		assert(Signal_StartAcquisition(fixture.signals[0], 1000) == EC_ACQUISITION_RUNNING);
+
+		// a stalled consumer: 10 kS/s for 300 ms overflows a 1024 sample ring
+		SleepMs(300);
+
+		uint64_t available, highWater, overruns;
+		assert(Signal_GetAcquisitionStats(fixture.signals[0], &available, &highWater, &overruns) == EC_OK);
+		assert(highWater == 1024 && overruns > 0);
+
+		long drained = 0;
+		int count;
+		while((count = Signal_Drain(fixture.signals[0], values, timestamps, BENCH_BLOCK)) > 0) {
+			for(int i = 1; i < count; ++i)
+				assert(timestamps[i] > timestamps[i - 1]);
+			drained += count;
+		}
+		assert(count == 0 && drained >= 1024);
+
+		Info();
+		printf("Test_Acquisition: drained %ld, high water %llu, overruns %llu\n", drained,
+			   (unsigned long long)highWater, (unsigned long long)overruns);
+		ResetColors();
+
+		assert(Signal_StopAcquisition(fixture.signals[0]) == EC_OK);
+		assert(Signal_StopAcquisition(fixture.signals[0]) == EC_UNINITIALIZED);
+
+		// freeing the last handle stops a running acquisition as well
+		assert(Signal_StartAcquisition(fixture.signals[0], 1 << 16) == EC_OK);
+	} while(0);
+
+	free(values);
+	free(timestamps);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_Acquisition: Success\n");
+	ResetColors();
+}
+
+// A block read as t0 + i * dt has to line up with the next one
+static void CheckAxisContinues(const TimeAxis* previous, const TimeAxis* next)
+{
+	const double expected = (double)previous->t0 + previous->count * previous->dt * 1e9;
+	assert(previous->discontinuities == 0 && next->discontinuities == 0);
+	assert(next->t0 - expected < 2 && expected - next->t0 < 2);
+}
+
+void Test_LinearAxis()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, "10000");
+
+	double values[2][1000];
+	double* data[2] = { values[0], values[1] };
+	TimeBreak breaks[8];
+	TimeAxis first, second;
+
+	do {
+		PrintInfo("Reading With A Compressed Time Axis");
+
+		assert(Signal_ReadLinear(fixture.dev, values[0], 1000, 0, &first, NULL, 0) == EC_OBJECT_TYPE_MISMATCH);
+		assert(Signal_ReadLinear(fixture.signals[0], values[0], 1000, 0, NULL, NULL, 0) == EC_INVALID_POINTER);
+
+		// the first call creates the reader, then full blocks arrive every 100 ms
+		Signal_ReadLinear(fixture.signals[0], values[0], 1000, 0, &first, breaks, 8);
+		assert(Signal_ReadLinear(fixture.signals[0], values[0], 1000, 1000, &first, breaks, 8) == 1000);
+		assert(Signal_ReadLinear(fixture.signals[0], values[0], 1000, 1000, &second, breaks, 8) == 1000);
+
+		assert(first.count == 1000 && first.dt > 0.99e-4 && first.dt < 1.01e-4);
+		CheckAxisContinues(&first, &second);
+
+		Info();
+		printf("Test_LinearAxis: t0 %s, dt %g s\n", TimeStampToString(first.t0), first.dt);
+		ResetColors();
+	} while(0);
+
+	do {
+		PrintInfo("Reading A Multi Reader With A Compressed Time Axis");
+
+		int64_t multireaderId = MultiReader_Bind(fixture.signals, 2);
+
+		MultiReader_ReadLinear(multireaderId, 1000, 0, data, &first, breaks, 8);
+		assert(MultiReader_ReadLinear(multireaderId, 1000, 1000, data, &first, breaks, 8) == 1000);
+		assert(MultiReader_ReadLinear(multireaderId, 1000, 1000, data, &second, NULL, 0) == 1000);
+
+		CheckAxisContinues(&first, &second);
+
+		MultiReader_UnBind(multireaderId);
+	} while(0);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_LinearAxis: Success\n");
+	ResetColors();
+}
+
+void Test_TickReads()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, "10000");
+
+	double values[2][1000];
+	int64_t ticks[2][1000];
+	double* data[2] = { values[0], values[1] };
+	int64_t* domain[2] = { ticks[0], ticks[1] };
+	TickDomain info;
+
+	do {
+		PrintInfo("Reading Raw Domain Ticks");
+
+		assert(Signal_GetDomainInfo(fixture.dev, &info) == EC_OBJECT_TYPE_MISMATCH);
+		assert(Signal_GetDomainInfo(fixture.signals[0], &info) == EC_OK);
+		assert(info.num > 0 && info.den > 0 && info.delta > 0);
+
+		Info();
+		printf("Test_TickReads: tick = %lld/%lld %s, delta %lld\n", (long long)info.num, (long long)info.den,
+			   info.unit, (long long)info.delta);
+		ResetColors();
+
+		Signal_ReadTicksInto(fixture.signals[0], values[0], ticks[0], 1000, 0);
+		assert(Signal_ReadTicksInto(fixture.signals[0], values[0], ticks[0], 1000, 1000) == 1000);
+
+		for(int i = 1; i < 1000; ++i)
+			assert(ticks[0][i] - ticks[0][i - 1] == info.delta);
+
+		// only the last sample gets converted, in place; the reference device runs on the wall clock
+		assert(Signal_TicksToTime(fixture.signals[0], &ticks[0][999], &ticks[0][999], 1) == EC_OK);
+		const int64_t age = (int64_t)time(NULL) - ticks[0][999] / 1000000000;
+		assert(age > -60 && age < 60);
+	} while(0);
+
+	do {
+		PrintInfo("Alternating Time And Tick Reads");
+
+		// both share one reader, so the tick read picks up right after the time read
+		assert(Signal_ReadInto(fixture.signals[0], values[0], ticks[0], 500, 1000) == 500);
+		assert(Signal_ReadTicksInto(fixture.signals[0], values[1], ticks[1], 500, 1000) == 500);
+
+		int64_t previous = ticks[1][0] - info.delta;
+		assert(Signal_TicksToTime(fixture.signals[0], &previous, &previous, 1) == EC_OK);
+		assert(previous == ticks[0][499]);
+	} while(0);
+
+	do {
+		PrintInfo("Reading Raw Domain Ticks From A Multi Reader");
+
+		int64_t multireaderId = MultiReader_BindTicks(fixture.signals, 2);
+		assert(multireaderId >= 0);
+
+		MultiReader_ReadToArrays(multireaderId, 1000, 0, data, domain);
+		assert(MultiReader_ReadToArrays(multireaderId, 1000, 1000, data, domain) == 1000);
+
+		for(int i = 1; i < 1000; ++i)
+			assert(ticks[0][i] - ticks[0][i - 1] == info.delta && ticks[1][i] == ticks[0][i]);
+
+		MultiReader_UnBind(multireaderId);
+	} while(0);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_TickReads: Success\n");
+	ResetColors();
+}
+
+#define ENVELOPE_SAMPLES 10000
+#define ENVELOPE_BINS    100
+
+void Test_Envelope()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, "100000");
+
+	double min[2][ENVELOPE_BINS], max[2][ENVELOPE_BINS], first[2][ENVELOPE_BINS], last[2][ENVELOPE_BINS];
+	int64_t binTimes[ENVELOPE_BINS];
+
+	do {
+		PrintInfo("Reading A Min/Max Envelope");
+
+		assert(Signal_ReadEnvelope(fixture.signals[0], ENVELOPE_SAMPLES, 0, min[0], max[0], NULL, NULL, NULL, 0) == EC_INSUFFICIENT_SIZE);
+
+		Signal_ReadEnvelope(fixture.signals[0], ENVELOPE_SAMPLES, ENVELOPE_BINS, min[0], max[0], NULL, NULL, NULL, 0);
+		assert(Signal_ReadEnvelope(fixture.signals[0], ENVELOPE_SAMPLES, ENVELOPE_BINS, min[0], max[0],
+								   first[0], last[0], binTimes, 1000) == ENVELOPE_BINS);
+
+		for(int i = 0; i < ENVELOPE_BINS; ++i) {
+			assert(min[0][i] <= first[0][i] && first[0][i] <= max[0][i]);
+			assert(min[0][i] <= last[0][i] && last[0][i] <= max[0][i]);
+			if(i > 0)
+				assert(binTimes[i] > binTimes[i - 1]);
+		}
+
+		Info();
+		printf("Test_Envelope: bin 0 [%f, %f]\n", min[0][0], max[0][0]);
+		ResetColors();
+	} while(0);
+
+	do {
+		PrintInfo("Reading A Min/Max Envelope From A Multi Reader");
+
+		double* mins[2] = { min[0], min[1] };
+		double* maxs[2] = { max[0], max[1] };
+
+		int64_t multireaderId = MultiReader_Bind(fixture.signals, 2);
+
+		MultiReader_ReadEnvelope(multireaderId, ENVELOPE_SAMPLES, ENVELOPE_BINS, 0, mins, maxs, NULL, NULL, NULL);
+		assert(MultiReader_ReadEnvelope(multireaderId, ENVELOPE_SAMPLES, ENVELOPE_BINS, 1000,
+										mins, maxs, NULL, NULL, binTimes) == ENVELOPE_BINS);
+
+		for(int i = 0; i < ENVELOPE_BINS; ++i)
+			assert(min[0][i] <= max[0][i] && min[1][i] <= max[1][i]);
+
+		MultiReader_UnBind(multireaderId);
+	} while(0);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_Envelope: Success\n");
+	ResetColors();
+}
+
+static void CheckStats(const BlockStats* stats, uint64_t count)
+{
+	assert(stats->count == count);
+	assert(stats->min <= stats->mean && stats->mean <= stats->max);
+	assert(stats->peakToPeak == stats->max - stats->min);
+	assert(stats->stddev >= 0 && stats->rms * stats->rms >= stats->mean * stats->mean * (1 - 1e-12));
+}
+
+void Test_BlockStats()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, "10000");
+
+	BlockStats stats[2];
+
+	do {
+		PrintInfo("Reading Block Statistics");
+
+		assert(Signal_ReadStats(fixture.signals[0], 1000, 0, NULL) == EC_INVALID_POINTER);
+
+		Signal_ReadStats(fixture.signals[0], 1000, 0, &stats[0]);
+		assert(Signal_ReadStats(fixture.signals[0], 1000, 1000, &stats[0]) == 1000);
+		CheckStats(&stats[0], 1000);
+
+		Info();
+		printf("Test_BlockStats: mean %f, rms %f, std %f, p-p %f\n",
+			   stats[0].mean, stats[0].rms, stats[0].stddev, stats[0].peakToPeak);
+		ResetColors();
+	} while(0);
+
+	do {
+		PrintInfo("Reading Block Statistics From A Multi Reader");
+
+		int64_t multireaderId = MultiReader_Bind(fixture.signals, 2);
+
+		MultiReader_ReadStats(multireaderId, 1000, 0, stats);
+		assert(MultiReader_ReadStats(multireaderId, 1000, 1000, stats) == 1000);
+		CheckStats(&stats[0], 1000);
+		CheckStats(&stats[1], 1000);
+
+		MultiReader_UnBind(multireaderId);
+	} while(0);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_BlockStats: Success\n");
+	ResetColors();
+}
+
+void Test_TimeoutModes()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, "10000");
+
+	double values[2][BENCH_BLOCK];
+	double* data[2] = { values[0], values[1] };
+	uint64_t available = 0;
+
+	do {
+		PrintInfo("Reading With The Timeout Modes");
+
+		assert(Signal_SetReadTimeoutMode(fixture.signals[0], 3) == EC_ARRAY_OUT_OF_BOUNDS);
+		assert(Signal_GetAvailableCount(fixture.signals[0], &available) == EC_OK);
+
+		// ANY returns well before the 10 s timeout, with less than the requested block
+		assert(Signal_SetReadTimeoutMode(fixture.signals[0], READ_TIMEOUT_ANY) == EC_OK);
+		double start = NowSeconds();
+		int count = Signal_ReadInto(fixture.signals[0], values[0], NULL, BENCH_BLOCK, 10000);
+		assert(count > 0 && count < BENCH_BLOCK && NowSeconds() - start < 5);
+
+		// NONE ignores the timeout and takes exactly what is queued
+		assert(Signal_SetReadTimeoutMode(fixture.signals[0], READ_TIMEOUT_NONE) == EC_OK);
+		SleepMs(100);
+		assert(Signal_GetAvailableCount(fixture.signals[0], &available) == EC_OK && available > 0);
+		start = NowSeconds();
+		count = Signal_ReadInto(fixture.signals[0], values[0], NULL, BENCH_BLOCK, 10000);
+		assert(count >= (int)available && NowSeconds() - start < 1);
+
+		Info();
+		printf("Test_TimeoutModes: %llu queued, took %d\n", (unsigned long long)available, count);
+		ResetColors();
+
+		assert(Signal_SetReadTimeoutMode(fixture.signals[0], READ_TIMEOUT_ALL) == EC_OK);
+	} while(0);
+
+	do {
+		PrintInfo("Reading A Multi Reader Without Blocking");
+
+		int64_t multireaderId = MultiReader_Bind(fixture.signals, 2);
+
+		assert(MultiReader_SetReadTimeoutMode(multireaderId, READ_TIMEOUT_NONE) == EC_OK);
+		SleepMs(100);
+		assert(MultiReader_GetAvailableCount(multireaderId, &available) == EC_OK && available > 0);
+
+		int64_t* timestamps[2] = { malloc(BENCH_BLOCK * sizeof(int64_t)), malloc(BENCH_BLOCK * sizeof(int64_t)) };
+
+		double start = NowSeconds();
+		int count = MultiReader_ReadToArrays(multireaderId, BENCH_BLOCK, 10000, data, timestamps);
+		assert(count >= (int)available && NowSeconds() - start < 1);
+
+		free(timestamps[0]);
+		free(timestamps[1]);
+
+		MultiReader_UnBind(multireaderId);
+	} while(0);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_TimeoutModes: Success\n");
+	ResetColors();
+}
+
+// Reads until the sample rate change shows up as a domain descriptor event
+static int ReadUntilRateChange(DaqObjectPtr signal, double* values, int64_t* ticks)
+{
+	ReadInfo info;
+
+	for(int i = 0; i < 50; ++i) {
+		Signal_ReadTicksInto(signal, values, ticks, 1000, 100);
+		assert(Signal_GetReadInfo(signal, &info) == EC_OK);
+
+		if(info.events & READ_EVENT_DOMAIN_DESCRIPTOR)
+			return 1;
+	}
+	return 0;
+}
+
+void Test_ReadStatus()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, "10000");
+
+	double values[2][1000];
+	int64_t ticks[2][1000];
+	double* data[2] = { values[0], values[1] };
+	int64_t* domain[2] = { ticks[0], ticks[1] };
+	ReadInfo info;
+	TickDomain before, after;
+
+	do {
+		PrintInfo("Following A Sample Rate Change");
+
+		assert(Signal_GetReadInfo(fixture.dev, &info) == EC_OBJECT_TYPE_MISMATCH);
+
+		Signal_ReadTicksInto(fixture.signals[0], values[0], ticks[0], 1000, 0);
+		assert(Signal_ReadTicksInto(fixture.signals[0], values[0], ticks[0], 1000, 1000) == 1000);
+		assert(Signal_GetReadInfo(fixture.signals[0], &info) == EC_OK && info.status == READ_STATUS_OK);
+		assert(Signal_GetDomainInfo(fixture.signals[0], &before) == EC_OK);
+
+		OpenDaqObject_Set(fixture.dev, "GlobalSampleRate", "20000");
+		assert(ReadUntilRateChange(fixture.signals[0], values[0], ticks[0]));
+
+		Info();
+		printf("Test_ReadStatus: last event %s\n", info.lastEvent);
+		ResetColors();
+
+		// the reader keeps going at the new rate without being rebound
+		assert(Signal_ReadTicksInto(fixture.signals[0], values[0], ticks[0], 1000, 1000) == 1000);
+		assert(Signal_GetDomainInfo(fixture.signals[0], &after) == EC_OK);
+		assert(after.delta * after.num * before.den == before.delta * before.num * after.den / 2);
+		assert(ticks[0][1] - ticks[0][0] == after.delta);
+	} while(0);
+
+	do {
+		PrintInfo("Following A Sample Rate Change On A Multi Reader");
+
+		int64_t multireaderId = MultiReader_Bind(fixture.signals, 2);
+
+		MultiReader_ReadToArrays(multireaderId, 1000, 0, data, domain);
+		assert(MultiReader_ReadToArrays(multireaderId, 1000, 1000, data, domain) == 1000);
+
+		OpenDaqObject_Set(fixture.dev, "GlobalSampleRate", "10000");
+
+		int changed = 0;
+		for(int i = 0; i < 50 && !changed; ++i) {
+			MultiReader_ReadToArrays(multireaderId, 1000, 100, data, domain);
+			assert(MultiReader_GetReadInfo(multireaderId, &info) == EC_OK);
+			changed = (info.events & READ_EVENT_DOMAIN_DESCRIPTOR) != 0;
+		}
+		assert(changed);
+
+		assert(MultiReader_ReadToArrays(multireaderId, 1000, 1000, data, domain) == 1000);
+
+		MultiReader_UnBind(multireaderId);
+	} while(0);
 
-#define UGLYCAST(x) (*(void **) (&x))
+	Fixture_Teardown(&fixture);
 
-#define GETFUN(x, handle) (UGLYCAST(x) = dlsym(handle, #x))
+	Success();
+	puts("Test_ReadStatus: Success\n");
+	ResetColors();
+}
 
-typedef void* DaqObjectPtr;
-typedef void** DaqObjectPtrArray;
+#define VECTOR_LABELS 8192
+#define VECTOR_SAMPLES 4
+void Test_VectorReads()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, "10000");
 
+	static double labels[VECTOR_LABELS];
+	static double values[VECTOR_SAMPLES * VECTOR_LABELS];
+	int64_t times[VECTOR_SAMPLES];
+	uint64_t elements = 0;
 
-char*		  (*LibraryInfo)		     (void);
-void 		  (*LibraryHelp) 			 (void);
-void          (*StdOut_PipeToString)     (void);
-const char*   (*StdOut_GetBufferString)  (void);
-void          (*StdOut_Default)          (void);
-void          (*StdOut_EraseBuffer)      (void);
+	do {
+		PrintInfo("Scalar Signals Have No Dimensions");
 
-DaqObjectPtr (*Instance_New)         	 (void);
-void         (*OpenDaqObject_Free)       (DaqObjectPtr self);
-void         (*StringPool_Free)       	 (const char* str);
+		assert(Signal_GetDimensions(fixture.signals[0], &elements, NULL, 0) == EC_NOT_AVAILABLE);
+		assert(elements == 1);
+		assert(Signal_GetDimensions(fixture.dev, &elements, NULL, 0) == EC_OBJECT_TYPE_MISMATCH);
+	} while(0);
 
-int          (*OpenDaqObject_Print)   (DaqObjectPtr self, const char* item);
-int          (*OpenDaqObject_List)    (DaqObjectPtr self, const char* type);
-const char*  (*OpenDaqObject_Get)     (DaqObjectPtr self, const char* item);
-int          (*OpenDaqObject_GetCount)(DaqObjectPtr self, const char* itemArray);
-int          (*OpenDaqObject_Set)     (DaqObjectPtr self, const char* item, const char* value);
-DaqObjectPtr (*OpenDaqObject_Select)  (DaqObjectPtr self, const char* type, uint64_t index);
-void         (*OpenDaqObject_Help)    (DaqObjectPtr self);
+	do {
+		PrintInfo("Reading Spectra Of The FFT Block");
 
-DaqObjectPtr (*Device_Add)              (DaqObjectPtr device, const char* type, const char* value);
-DaqObjectPtr (*Device_AddDevice)        (DaqObjectPtr device, const char* connectionString);
-DaqObjectPtr (*Device_AddFunctionBlock) (DaqObjectPtr device, const char* fbId);
-int          (*Device_Remove)           (DaqObjectPtr device, const char* type, uint64_t index);
-int          (*Device_RemoveDevice)     (DaqObjectPtr device, uint64_t index);
-int          (*Device_RemoveFunctionBlock)(DaqObjectPtr device, uint64_t index);
+		char id[256];
+		assert(OpenDaqObject_GetToBuffer(fixture.signals[0], "id", id, sizeof(id), NULL) == EC_OK);
 
-const char*  (*Device_GetAvailableDeviceConnectionString)(DaqObjectPtr device, uint64_t index);
-const char*  (*Device_GetAvailableFunctionBlockID)(DaqObjectPtr device, uint64_t index);
+		DaqObjectPtr fft = Device_AddFunctionBlock(fixture.instance, "RefFBModuleFFT");
+		assert(fft);
+		DaqObjectPtr port = OpenDaqObject_Select(fft, "input-port", 0);
+		assert(port);
+		assert(InputPort_Connect(port, id, fixture.instance) == EC_OK);
 
-int          (*Device_LoadConfiguration)(DaqObjectPtr device, const char* json);
-int          (*Device_LoadConfigurationFromFile)(DaqObjectPtr device, const char* json_path);
-const char*  (*Device_SaveConfiguration)(DaqObjectPtr device);
-int          (*Device_SaveConfigurationToFile)(DaqObjectPtr device, const char* json_path);
+		DaqObjectPtr spectrum = OpenDaqObject_Select(fft, "signal", 0);
+		assert(spectrum);
 
-int          (*InputPort_Connect)(DaqObjectPtr port, const char* signalid, DaqObjectPtr instance);
-int          (*InputPort_Disconnect)(DaqObjectPtr port);
+		assert(Signal_GetDimensions(spectrum, &elements, NULL, 0) == EC_OK);
+		assert(elements > 1 && elements <= VECTOR_LABELS);
+		assert(Signal_GetDimensions(spectrum, &elements, labels, elements - 1) == EC_INSUFFICIENT_SIZE);
+		assert(Signal_GetDimensions(spectrum, &elements, labels, VECTOR_LABELS) == EC_OK);
+		assert(labels[1] > labels[0]);
 
-int          (*Signal_Read)(DaqObjectPtr signal, uint64_t NumOfSamples, int timeout);
+		assert(Signal_ReadVectors(spectrum, NULL, NULL, 0, 0) == 0);
 
-double*      (*Signal_GetSampleReadings)(DaqObjectPtr signal);
-int64_t*     (*Signal_GetSampleTimeStamps)(DaqObjectPtr signal);
+		int read = 0;
+		for(int i = 0; i < 50 && read < VECTOR_SAMPLES; ++i)
+			read += Signal_ReadVectors(spectrum, values + read * elements, times + read, VECTOR_SAMPLES - read, 100);
+		assert(read == VECTOR_SAMPLES);
 
-int          (*Signal_GetSampleReadingsToArray)(DaqObjectPtr signal, double* array, uint64_t len);
-int          (*Signal_GetSampleTimeStampsToArray)(DaqObjectPtr signal, int64_t* array, uint64_t len);
+		for(int i = 1; i < VECTOR_SAMPLES; ++i)
+			assert(times[i] > times[i - 1]);
 
-int          (*Signal_GetSampleCountOfRead)(DaqObjectPtr signal);
-int          (*Signal_EraseSamples)(DaqObjectPtr signal);
-const char*  (*TimeStampToString)(int64_t timestamp);
+		Info();
+		printf("Test_VectorReads: %llu bins from %f to %f\n", (unsigned long long)elements, labels[0], labels[elements - 1]);
+		ResetColors();
 
-int          (*Signal_SendDataPacket)(DaqObjectPtr signal, double* data, uint64_t count);
-int          (*Signal_SendTestDataPacket)(DaqObjectPtr signal, uint64_t count, double sine_range);
+		// the descriptor keeps its dimensions through a JSON round trip
+		DaqObjectPtr descriptor = OpenDaqObject_Select(spectrum, "descriptor", 0);
+		assert(descriptor);
+		const char* json = DataDescriptor_SaveToJson(descriptor);
+		assert(json && strstr(json, "\"dimensions\""));
+		StringPool_Free(json);
+		OpenDaqObject_Free(descriptor);
 
-int          (*Signal_LoadDataDescriptorFromJson)(DaqObjectPtr signal, const char* json);
-int          (*Signal_LoadDataDescriptorFromJsonFile)(DaqObjectPtr signal, const char* path);
+		InputPort_Disconnect(port);
+		OpenDaqObject_Free(spectrum);
+		OpenDaqObject_Free(port);
+		OpenDaqObject_Free(fft);
+	} while(0);
 
-const char*  (*DataDescriptor_SaveToJson)(DaqObjectPtr signal);
-int          (*DataDescriptor_SaveToJsonFile)(DaqObjectPtr signal, const char* path);
+	Fixture_Teardown(&fixture);
 
-int 		 (*MultiReader_ReadToArrays)(int64_t multiReaderId,
-										 uint64_t NumOfSamples, int timeout,
-										 double** data, int64_t** timestamps);
+	Success();
+	puts("Test_VectorReads: Success\n");
+	ResetColors();
+}
 
-int64_t      (*MultiReader_Bind)(DaqObjectPtrArray signals, uint64_t NumOfSignals);
-int          (*MultiReader_UnBind)(int64_t multiReaderId);
+// Record of the reference device's CAN channel, as Signal_GetStructLayout describes it
+#pragma pack(push, 1)
+typedef struct CanRecord
+{
+	int32_t arbId;
+	int8_t  length;
+	uint8_t data[64];
+} CanRecord;
+#pragma pack(pop)
+
+#define STRUCT_RECORDS 16
+void Test_StructReads()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, "10000");
+	OpenDaqObject_Set(fixture.dev, "EnableCANChannel", "true");
 
+	// the CAN channel comes after the analog ones
+	DaqObjectPtr can = OpenDaqObject_Resolve(fixture.dev, "channel/2/signal/0");
+	assert(fixture.signals[0] && can);
 
-void InitFunctions(void* handle)
+	StructField fields[8];
+	uint64_t count = 0, recordSize = 0;
+	CanRecord records[STRUCT_RECORDS];
+	int64_t times[STRUCT_RECORDS];
+
+	do {
+		PrintInfo("Deriving The Record Layout");
+
+		assert(Signal_GetStructLayout(fixture.signals[0], fields, 8, &count, &recordSize) == EC_NOT_AVAILABLE);
+		assert(Signal_ReadStructs(fixture.signals[0], records, NULL, 1, 0) == EC_NOT_AVAILABLE);
+
+		assert(Signal_GetStructLayout(can, NULL, 0, &count, &recordSize) == EC_OK);
+		assert(count == 3 && recordSize == sizeof(CanRecord));
+		assert(Signal_GetStructLayout(can, fields, 2, &count, &recordSize) == EC_INSUFFICIENT_SIZE);
+		assert(Signal_GetStructLayout(can, fields, 8, &count, &recordSize) == EC_OK);
+
+		assert(fields[0].sampleType == SAMPLE_TYPE_INT32 && fields[0].offset == 0);
+		assert(fields[1].sampleType == SAMPLE_TYPE_INT8 && fields[1].offset == 4);
+		assert(fields[2].sampleType == SAMPLE_TYPE_UINT8 && fields[2].offset == 5 && fields[2].elements == 64);
+
+		for(uint64_t i = 0; i < count; ++i)
+			printf("Test_StructReads: %s at %u, %u bytes\n", fields[i].name, fields[i].offset, fields[i].size);
+	} while(0);
+
+	do {
+		PrintInfo("Reading Records");
+
+		assert(Signal_ReadStructs(can, NULL, NULL, 0, 0) == 0);
+
+		int read = 0;
+		for(int i = 0; i < 50 && read < STRUCT_RECORDS; ++i)
+			read += Signal_ReadStructs(can, records + read, times + read, STRUCT_RECORDS - read, 100);
+		assert(read == STRUCT_RECORDS);
+
+		for(int i = 0; i < STRUCT_RECORDS; ++i)
+			assert(records[i].length >= 0 && records[i].length <= 64);
+		for(int i = 1; i < STRUCT_RECORDS; ++i)
+			assert(times[i] >= times[i - 1]);
+
+		Info();
+		printf("Test_StructReads: first frame id %d, %d bytes\n", records[0].arbId, records[0].length);
+		ResetColors();
+	} while(0);
+
+	do {
+		PrintInfo("Borrowing Records From The Packets");
+
+		const void* borrowed = NULL;
+		assert(Signal_BorrowStructs(fixture.signals[0], &borrowed, NULL, 1, 0) == EC_NOT_AVAILABLE);
+		assert(Signal_BorrowStructs(can, NULL, NULL, 1, 0) == EC_INVALID_POINTER);
+
+		int read = 0;
+		for(int i = 0; i < 50 && read < STRUCT_RECORDS; ++i) {
+			int n = Signal_BorrowStructs(can, &borrowed, times + read, STRUCT_RECORDS - read, 100);
+			assert(n >= 0 && n <= STRUCT_RECORDS - read);
+			assert(!n || borrowed);
+
+			// the records are the packet memory, in the layout the copying read uses
+			if(n)
+				memcpy(records + read, borrowed, n * sizeof(CanRecord));
+			read += n;
+		}
+		assert(read == STRUCT_RECORDS);
+		assert(Signal_ReleaseStructs(can) == EC_OK);
+
+		for(int i = 0; i < STRUCT_RECORDS; ++i)
+			assert(records[i].length >= 0 && records[i].length <= 64);
+		for(int i = 1; i < STRUCT_RECORDS; ++i)
+			assert(times[i] >= times[i - 1]);
+	} while(0);
+
+	OpenDaqObject_Free(can);
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_StructReads: Success\n");
+	ResetColors();
+}
+
+void Test_MultiReaderIds()
 {
+	Fixture fixture;
+	Fixture_Setup(&fixture, 3, "10000");
 
-	GETFUN(LibraryHelp, handle);
-	GETFUN(LibraryInfo, handle);
-	GETFUN(StdOut_Default, handle);
-	GETFUN(StdOut_GetBufferString, handle);
-	GETFUN(StdOut_PipeToString, handle);
-	GETFUN(StdOut_EraseBuffer, handle);
+	double values[100];
+	int64_t times[100];
+	double* data[1] = { values };
+	int64_t* domain[1] = { times };
+	uint64_t available;
 
-	GETFUN(Instance_New, handle);
-	GETFUN(OpenDaqObject_Free, handle);
-	GETFUN(StringPool_Free, handle);
+	do {
+		PrintInfo("Unbinding Leaves The Other IDs Alone");
 
-	GETFUN(OpenDaqObject_Print, handle);
-	GETFUN(OpenDaqObject_List, handle);
-	GETFUN(OpenDaqObject_Get, handle);
-	GETFUN(OpenDaqObject_GetCount, handle);
-	GETFUN(OpenDaqObject_Set, handle);
-	GETFUN(OpenDaqObject_Select, handle);
-	GETFUN(OpenDaqObject_Help, handle);
+		int64_t ids[3];
+		for(int i = 0; i < 3; ++i) {
+			ids[i] = MultiReader_Bind(&fixture.signals[i], 1);
+			assert(ids[i] > 0);
+		}
 
-	GETFUN(Device_Add, handle);
-	GETFUN(Device_AddDevice, handle);
-	GETFUN(Device_AddFunctionBlock, handle);
-	GETFUN(Device_Remove, handle);
-	GETFUN(Device_RemoveDevice, handle);
-	GETFUN(Device_RemoveFunctionBlock, handle);
+		assert(MultiReader_UnBind(ids[1]) == EC_OK);
+		assert(MultiReader_GetAvailableCount(ids[1], &available) == EC_ARRAY_OUT_OF_BOUNDS);
 
-	GETFUN(Device_GetAvailableDeviceConnectionString, handle);
-	GETFUN(Device_GetAvailableFunctionBlockID, handle);
+		// the readers bound after the released one still read their own signal
+		assert(MultiReader_ReadToArrays(ids[0], 100, 1000, data, domain) == 100);
+		assert(MultiReader_ReadToArrays(ids[2], 100, 1000, data, domain) == 100);
 
-	GETFUN(Device_LoadConfiguration, handle);
-	GETFUN(Device_LoadConfigurationFromFile, handle);
-	GETFUN(Device_SaveConfiguration, handle);
-	GETFUN(Device_SaveConfigurationToFile, handle);
+		// the slot is reused, the old ID is not
+		int64_t rebound = MultiReader_Bind(&fixture.signals[1], 1);
+		assert(rebound > 0 && rebound != ids[1]);
+		assert(MultiReader_GetAvailableCount(ids[1], &available) == EC_ARRAY_OUT_OF_BOUNDS);
+		assert(MultiReader_GetAvailableCount(rebound, &available) == EC_OK);
 
-	GETFUN(InputPort_Connect, handle);
-	GETFUN(InputPort_Disconnect, handle);
+		assert(MultiReader_GetAvailableCount(0, &available) == EC_ARRAY_OUT_OF_BOUNDS);
+		assert(MultiReader_GetAvailableCount(-1, &available) == EC_ARRAY_OUT_OF_BOUNDS);
 
-	GETFUN(Signal_Read, handle);
-	GETFUN(Signal_GetSampleReadings, handle);
-	GETFUN(Signal_GetSampleTimeStamps, handle);
-	GETFUN(Signal_GetSampleReadingsToArray, handle);
-	GETFUN(Signal_GetSampleTimeStampsToArray, handle);
-	GETFUN(Signal_GetSampleCountOfRead, handle);
-	GETFUN(Signal_EraseSamples, handle);
+		MultiReader_UnBind(rebound);
+		MultiReader_UnBind(ids[0]);
+		MultiReader_UnBind(ids[2]);
+		MultiReader_UnBind(ids[2]);
+	} while(0);
 
-	GETFUN(Signal_SendDataPacket, handle);
-	GETFUN(Signal_SendTestDataPacket, handle);
+	Fixture_Teardown(&fixture);
 
-	GETFUN(Signal_LoadDataDescriptorFromJson, handle);
-	GETFUN(Signal_LoadDataDescriptorFromJsonFile, handle);
+	Success();
+	puts("Test_MultiReaderIds: Success\n");
+	ResetColors();
+}
 
-	GETFUN(DataDescriptor_SaveToJson, handle);
-	GETFUN(DataDescriptor_SaveToJsonFile, handle);
+#define LAYOUT_SAMPLES 1000
+#define LAYOUT_SIGNALS 2
+void Test_BufferLayouts()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, "10000");
 
-	GETFUN(TimeStampToString, handle);
-	GETFUN(MultiReader_ReadToArrays, handle);
-	GETFUN(MultiReader_Bind, handle);
-	GETFUN(MultiReader_UnBind, handle);
+	// one padding element per row, which the reads must leave alone
+	static double values[(LAYOUT_SAMPLES + 1) * (LAYOUT_SIGNALS + 1)];
+	static int64_t times[(LAYOUT_SAMPLES + 1) * (LAYOUT_SIGNALS + 1)];
+
+	int64_t multireaderId = MultiReader_Bind(fixture.signals, LAYOUT_SIGNALS);
+	assert(multireaderId > 0);
+
+	do {
+		PrintInfo("Reading [channel][sample] Rows");
+
+		const uint64_t stride = LAYOUT_SAMPLES + 1;
+		for(uint64_t i = 0; i < LAYOUT_SIGNALS * stride; ++i)
+			times[i] = -1;
+
+		assert(MultiReader_ReadToBuffer(multireaderId, LAYOUT_SAMPLES, 1000, BUFFER_LAYOUT_PLANAR,
+										LAYOUT_SAMPLES - 1, values, times) == EC_INSUFFICIENT_SIZE);
+		assert(MultiReader_ReadToBuffer(multireaderId, LAYOUT_SAMPLES, 1000, BUFFER_LAYOUT_PLANAR,
+										stride, values, times) == LAYOUT_SAMPLES);
+
+		for(int s = 0; s < LAYOUT_SAMPLES; ++s)
+			assert(times[s] == times[stride + s]);
+		for(int s = 1; s < LAYOUT_SAMPLES; ++s)
+			assert(times[s] > times[s - 1]);
+		assert(times[LAYOUT_SAMPLES] == -1);
+	} while(0);
+
+	do {
+		PrintInfo("Reading [sample][channel] Rows");
+
+		const uint64_t stride = LAYOUT_SIGNALS + 1;
+		for(uint64_t i = 0; i < LAYOUT_SAMPLES * stride; ++i)
+			times[i] = -1;
+
+		assert(MultiReader_ReadToBuffer(multireaderId, LAYOUT_SAMPLES, 1000, 7, 0, values, times) == EC_ARRAY_OUT_OF_BOUNDS);
+		assert(MultiReader_ReadToBuffer(multireaderId, LAYOUT_SAMPLES, 1000, BUFFER_LAYOUT_INTERLEAVED,
+										1, values, times) == EC_INSUFFICIENT_SIZE);
+		// a dense block without timestamps
+		assert(MultiReader_ReadToBuffer(multireaderId, LAYOUT_SAMPLES, 1000, BUFFER_LAYOUT_INTERLEAVED,
+										0, values, NULL) == LAYOUT_SAMPLES);
+		assert(MultiReader_ReadToBuffer(multireaderId, LAYOUT_SAMPLES, 1000, BUFFER_LAYOUT_INTERLEAVED,
+										stride, values, times) == LAYOUT_SAMPLES);
+
+		for(int s = 0; s < LAYOUT_SAMPLES; ++s) {
+			assert(times[s * stride] == times[s * stride + 1]);
+			assert(times[s * stride + 2] == -1);
+		}
+		for(int s = 1; s < LAYOUT_SAMPLES; ++s)
+			assert(times[s * stride] > times[(s - 1) * stride]);
+
+		Info();
+		printf("Test_BufferLayouts: first record %f, %f\n", values[0], values[1]);
+		ResetColors();
+
+		assert(MultiReader_ReadToBuffer(multireaderId, LAYOUT_SAMPLES, 1000, BUFFER_LAYOUT_INTERLEAVED,
+										0, NULL, NULL) == EC_INVALID_POINTER);
+	} while(0);
+
+	MultiReader_UnBind(multireaderId);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_BufferLayouts: Success\n");
+	ResetColors();
 }
 
-void SaveToCSV(const char* path, double* values, int size)
+#define SHARED_SAMPLES 1000
+void Test_SharedTimestamps()
 {
-	FILE* f = fopen(path, "w");
-	if(!f) return;
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, "10000");
 
-	for(int i = 0; i < size-1; ++i) {
-		fprintf(f, "%f,", values[i]);
-	}
+	double values[2][SHARED_SAMPLES];
+	int64_t column[SHARED_SAMPLES];
+	double* data[2] = { values[0], values[1] };
 
-	fprintf(f, "%f\n", values[size-1]);
+	do {
+		PrintInfo("Reading One Timestamp Column For The Group");
+
+		int64_t multireaderId = MultiReader_Bind(fixture.signals, 2);
+		assert(multireaderId > 0);
+
+		assert(MultiReader_ReadShared(multireaderId, SHARED_SAMPLES, 1000, NULL, column) == EC_INVALID_POINTER);
+		assert(MultiReader_ReadShared(multireaderId, SHARED_SAMPLES, 1000, data, column) == SHARED_SAMPLES);
+
+		const int64_t step = column[1] - column[0];
+		assert(step > 0);
+		for(int i = 1; i < SHARED_SAMPLES; ++i)
+			assert(column[i] > column[i - 1]);
+
+		// converted like the TimeReader of a per-signal read, which continues the column
+		int64_t times[2][SHARED_SAMPLES];
+		int64_t* domain[2] = { times[0], times[1] };
+		assert(MultiReader_ReadToArrays(multireaderId, SHARED_SAMPLES, 1000, data, domain) == SHARED_SAMPLES);
+		assert(times[0][0] - column[SHARED_SAMPLES - 1] == step && times[1][0] == times[0][0]);
+
+		// and without timestamps at all
+		assert(MultiReader_ReadShared(multireaderId, SHARED_SAMPLES, 1000, data, NULL) == SHARED_SAMPLES);
+
+		Info();
+		printf("Test_SharedTimestamps: %lld between samples\n", (long long)step);
+		ResetColors();
+
+		MultiReader_UnBind(multireaderId);
+	} while(0);
+
+	do {
+		PrintInfo("Same Column In Ticks");
+
+		int64_t multireaderId = MultiReader_BindTicks(fixture.signals, 2);
+		assert(multireaderId > 0);
+
+		TickDomain domain;
+		assert(Signal_GetDomainInfo(fixture.signals[0], &domain) == EC_OK);
+
+		assert(MultiReader_ReadShared(multireaderId, SHARED_SAMPLES, 1000, data, column) == SHARED_SAMPLES);
+		for(int i = 1; domain.delta && i < SHARED_SAMPLES; ++i)
+			assert(column[i] - column[i - 1] == domain.delta);
+
+		MultiReader_UnBind(multireaderId);
+	} while(0);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_SharedTimestamps: Success\n");
+	ResetColors();
 }
 
+#ifndef _WIN32
+typedef struct
+{
+	pthread_mutex_t    mutex;
+	pthread_cond_t     ready;
+	unsigned long long available;
+	int                calls;
+} BlockWaiter;
 
-void Test_CheckStdOutRedirect()
+static void OnBlockReady(void* user, unsigned long long available)
 {
-	StdOut_PipeToString();
-	LibraryHelp();
-	const char* str = StdOut_GetBufferString();
-	StdOut_Default();
-	printf("%s", str);
-	const char* str2 = LibraryInfo();
-	assert(str);
-	assert(str2);
+	BlockWaiter* waiter = user;
 
-	puts(str);
-	puts(str2);
+	pthread_mutex_lock(&waiter->mutex);
+	waiter->available = available;
+	waiter->calls++;
+	pthread_cond_signal(&waiter->ready);
+	pthread_mutex_unlock(&waiter->mutex);
+}
 
-	StdOut_EraseBuffer();
+// Sleeps until the next callback, returns the samples it reported or 0 after a second
+static unsigned long long WaitForBlock(BlockWaiter* waiter)
+{
+	struct timespec deadline;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += 1;
+
+	pthread_mutex_lock(&waiter->mutex);
+	waiter->calls = 0;
+	waiter->available = 0;
+
+	while(waiter->calls == 0)
+		if(pthread_cond_timedwait(&waiter->ready, &waiter->mutex, &deadline) != 0)
+			break;
+
+	unsigned long long available = waiter->available;
+	pthread_mutex_unlock(&waiter->mutex);
+	return available;
+}
+
+void Test_DataCallback()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 2, "10000");
+
+	BlockWaiter waiter = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0 };
+	double values[2][1000];
+	int64_t timestamps[2][1000];
+
+	do {
+		PrintInfo("Waiting For Blocks Instead Of Polling");
+
+		assert(Signal_SetDataCallback(fixture.signals[0], OnBlockReady, &waiter, 1000) == EC_OK);
+		while(Signal_ReadInto(fixture.signals[0], values[0], timestamps[0], 1000, 0) == 1000);
+
+		unsigned long long available = WaitForBlock(&waiter);
+		assert(available >= 1000);
+		assert(Signal_ReadInto(fixture.signals[0], values[0], timestamps[0], 1000, 0) == 1000);
+
+		assert(Signal_SetDataCallback(fixture.signals[0], NULL, NULL, 0) == EC_OK);
+
+		int64_t multireaderId = MultiReader_Bind(fixture.signals, 2);
+		assert(multireaderId >= 0);
+		assert(MultiReader_SetDataCallback(multireaderId, OnBlockReady, &waiter, 500) == EC_OK);
+
+		double* data[2] = { values[0], values[1] };
+		int64_t* times[2] = { timestamps[0], timestamps[1] };
+
+		available = WaitForBlock(&waiter);
+		assert(available >= 500);
+		assert(MultiReader_ReadToArrays(multireaderId, 500, 0, data, times) == 500);
+
+		MultiReader_UnBind(multireaderId);
+	} while(0);
+
+	Fixture_Teardown(&fixture);
 
 	Success();
-	puts("Test_CheckStdOutRedirect: Success\n");
+	puts("Test_DataCallback: Success\n");
 	ResetColors();
 }
+#endif
+
+#define WIRED_PORTS 4
+void Test_ConnectMany()
+{
+	Fixture fixture;
+	Fixture_Setup(&fixture, 4, NULL);
 
+	DaqObjectPtr fbs[WIRED_PORTS];
+	DaqObjectPtr ports[WIRED_PORTS];
+	char ids[WIRED_PORTS][256];
+	const char* signalids[WIRED_PORTS];
+
+	do {
+		PrintInfo("Connecting Input Ports In One Call");
+
+		for(int i = 0; i < WIRED_PORTS; ++i) {
+			DaqObjectPtr channel = OpenDaqObject_Select(fixture.dev, "channel", i);
+			DaqObjectPtr signal = OpenDaqObject_Select(channel, "signal", 0);
+			assert(OpenDaqObject_GetToBuffer(signal, "id", ids[i], sizeof(ids[i]), NULL) == EC_OK);
+			signalids[i] = ids[i];
+			OpenDaqObject_Free(signal);
+			OpenDaqObject_Free(channel);
+
+			fbs[i] = Device_AddFunctionBlock(fixture.instance, "RefFBModuleStatistics");
+			assert(fbs[i]);
+			ports[i] = OpenDaqObject_Select(fbs[i], "input-port", 0);
+			assert(ports[i]);
+		}
+
+		assert(InputPort_ConnectMany(ports, signalids, WIRED_PORTS, fixture.instance) == EC_OK);
+
+		char connected[256];
+		for(int i = 0; i < WIRED_PORTS; ++i) {
+			assert(OpenDaqObject_GetToBuffer(ports[i], "signal-id", connected, sizeof(connected), NULL) == EC_OK);
+			assert(strcmp(connected, ids[i]) == 0);
+		}
+
+		// the remaining ports are still connected when one ID is unknown
+		signalids[1] = "/no/such/signal";
+		assert(InputPort_ConnectMany(ports, signalids, WIRED_PORTS, fixture.instance) == EC_SIGNAL_ID_INVALID);
+		assert(InputPort_Connect(ports[0], ids[0], fixture.instance) == EC_OK);
+
+		for(int i = 0; i < WIRED_PORTS; ++i) {
+			InputPort_Disconnect(ports[i]);
+			OpenDaqObject_Free(ports[i]);
+			OpenDaqObject_Free(fbs[i]);
+		}
+	} while(0);
+
+	Fixture_Teardown(&fixture);
+
+	Success();
+	puts("Test_ConnectMany: Success\n");
+	ResetColors();
+}
 
 static const char* test_config_path = "config.json";
 void Test_ChangeConfig()
@@ -309,7 +2056,7 @@ void Test_MultiRead()
 	do {
 		PrintInfo("Reading Samples From All Signals");
 
-		int multireaderId = MultiReader_Bind(signals, NUM_CHANNELS);
+		int64_t multireaderId = MultiReader_Bind(signals, NUM_CHANNELS);
 
 		int current = 0;
 		while(current < totalSamples) {
@@ -612,6 +2359,31 @@ void Test_CheckInstance()
 void Test_Main()
 {
 	Test_CheckStdOutRedirect();
+	Test_HandleValidation();
+	Bench_HandleValidation();
+	Test_StringBuffers();
+	Bench_PropertyGet();
+	Test_ResolvePath();
+	Test_ConnectMany();
+	Test_Snapshot();
+	Bench_SignalReadInto();
+	Test_TypedReads();
+	Test_Acquisition();
+	Test_LinearAxis();
+	Test_TickReads();
+	Test_Envelope();
+	Test_BlockStats();
+	Test_TimeoutModes();
+	Test_ReadStatus();
+	Test_VectorReads();
+	Test_StructReads();
+	Test_MultiReaderIds();
+	Test_BufferLayouts();
+	Test_SharedTimestamps();
+	Test_ConcurrentReads();
+#ifndef _WIN32
+	Test_DataCallback();
+#endif
 	//Test_ChangeConfig();
 	//Test_CheckInstance();
 	Test_MultiRead();
@@ -3,17 +3,25 @@
 #include <iostream>
 #include <fstream>
 #include <unordered_set>
+#include <unordered_map>
 #include <list>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 #include "ErrorCodes.h"
 #include "BoilerplateImpl/stdout_redirect.h"
 #include "BoilerplateImpl/OpenDaqObject.h"
 #include "BoilerplateImpl/util.h"
+#include "BoilerplateImpl/slot_map.h"
+#include "BoilerplateImpl/component_cache.h"
 
 #include "BoilerplateImpl/app_device.h"
 #include "BoilerplateImpl/app_input_port.h"
 #include "BoilerplateImpl/app_signal.h"
 #include "BoilerplateImpl/app_descriptor.h"
+#include "BoilerplateImpl/app_property_object.h"
 
 #include "opendaq/opendaq.h"
 
@@ -52,19 +60,143 @@ void          StdOut_EraseBuffer      (void)
 	EraseBuffer();
 }
 
-// keeping all allocated objects so we can check raw pointers validity
-std::unordered_set<OpenDaqObjectPtr> createdPtrs;
+// Handles given out by this library are generational slot map IDs (see slot_map.h).
+// The tag of every object is kept in its slot, so validation is a bounds check
+// plus a generation compare and type checks do not need a dynamic_cast.
+//
+// Concurrency model:
+//  - the handle table is sharded, each shard behind a reader-writer lock. Lookups
+//    copy a shared_ptr out under the shared lock, so an object stays alive for the
+//    duration of a call even if another thread frees its handle meanwhile
+//  - per-signal state (samples, reader) is guarded by AppSignal::samplesLock, so
+//    reads on different signals never wait on each other
+//  - string_pool has its own lock. Multi-readers live in a sharded slot map of their
+//    own, only binding and unbinding take the bound-signals lock; every bound
+//    multi-reader is additionally locked while it reads
+//  - Signal_StartAcquisition threads read through a reader of their own and hand
+//    samples over in a lock-free SPSC ring; Drain calls on one signal are serialized
+//  - the stdout redirect is process-wide; Print/List/Help write to it unsynchronized
+static_assert(sizeof(DaqObjectPtr) >= sizeof(SlotMap<OpenDaqObjectPtr>::Handle),
+			  "Handles need 64-bit pointers");
+
+using SharedObjectPtr = std::shared_ptr<OpenDaqObject>;
+
+struct HandleRef
+{
+	SharedObjectPtr value;
+	uint32_t        tag = 0;
+
+	explicit operator bool() const { return value != nullptr; }
+};
+
+static ShardedSlotMap<SharedObjectPtr> handles;
+
+static std::atomic<DaqObjectPtr> g_instance = nullptr;
+
+static HandleRef Lookup(DaqObjectPtr handle)
+{
+	HandleRef ref;
+	handles.find((uintptr_t)handle, ref.value, ref.tag);
+	return ref;
+}
+
+template <typename T>
+static T* Cast(const HandleRef& slot)
+{
+	return slot.tag == (uint32_t)T::Tag ? static_cast<T*>(slot.value.get()) : nullptr;
+}
+
+struct IdentityKey
+{
+	void*    identity;
+	uint32_t tag;
+
+	bool operator==(const IdentityKey& other) const
+	{
+		return identity == other.identity && tag == other.tag;
+	}
+};
+
+struct IdentityKeyHash
+{
+	size_t operator()(const IdentityKey& key) const
+	{
+		return std::hash<void*>()(key.identity) ^ key.tag;
+	}
+};
+
+struct InternedHandle
+{
+	DaqObjectPtr handle;
+	uint64_t     refs;
+};
+
+// Identity map from the underlying openDAQ object to its handle. Selecting a component
+// that already has a handle returns that handle with its refcount bumped, so per-object
+// state (e.g. the signal's StreamReader) survives and the table does not grow.
+// interned_lock is always taken before a handle shard lock
+static std::mutex interned_lock;
+static std::unordered_map<IdentityKey, InternedHandle, IdentityKeyHash> interned;
+
+// Components are reachable through several interfaces; IBaseObject gives a stable identity
+static IdentityKey IdentityOf(const BaseObjectPtr& object, ObjectTag tag)
+{
+	return { object.asPtr<daq::IBaseObject>(true).getObject(), (uint32_t)tag };
+}
+
+static IdentityKey IdentityOf(const OpenDaqObject& obj)
+{
+	return IdentityOf(obj.object, obj.tag);
+}
+
+static DaqObjectPtr Register(OpenDaqObjectPtr&& ptr)
+{
+	if(!ptr)
+		return nullptr;
+
+	auto key = IdentityOf(*ptr);
+	std::lock_guard guard(interned_lock);
+
+	auto it = interned.find(key);
+	if(it != interned.end()) {
+		++it->second.refs;
+		return it->second.handle;
+	}
+
+	auto handle = (DaqObjectPtr)(uintptr_t)handles.insert(std::move(ptr), key.tag);
+	interned.emplace(key, InternedHandle{ handle, 1 });
+	return handle;
+}
 
-OpenDaqObject* g_instance = nullptr;
+// Same as Register for an object the component cache returned; a wrapper is only
+// allocated when the object has no live handle yet, and built is used when the
+// lookup already had to make one
+static DaqObjectPtr RegisterResolved(const BaseObjectPtr& object, ObjectTag tag, OpenDaqObjectPtr&& built = nullptr)
+{
+	if(!object.assigned())
+		return nullptr;
+
+	{
+		std::lock_guard guard(interned_lock);
+
+		auto it = interned.find(IdentityOf(object, tag));
+		if(it != interned.end()) {
+			++it->second.refs;
+			return it->second.handle;
+		}
+	}
+
+	return Register(built ? std::move(built) : daq::ComponentCache::MakeWrapper(tag, object));
+}
 
 DaqObjectPtr    Instance_New                	(void)
 {
 	try {
 		auto instance_temp = daq::Instance(MODULE_PATH);
-		const auto& [iterator, _] =
-			createdPtrs.emplace(Make_OpenDaqObjectPtr<daq::AppDevice>(instance_temp));
+		daq::ComponentCache::Subscribe(instance_temp.getContext());
 
-		return g_instance = iterator->get();
+		return g_instance =
+			Register(Make_OpenDaqObjectPtr<daq::AppDevice>(instance_temp));
 	} catch(...) {
 		return nullptr;
 	}
@@ -72,59 +204,272 @@ DaqObjectPtr    Instance_New                	(void)
 
 void      OpenDaqObject_Free               	(DaqObjectPtr ptr)
 {
-	erase_uptr(createdPtrs, (OpenDaqObject*)ptr);
+	// destroyed after the lock is released
+	SharedObjectPtr released;
+
+	try {
+		std::lock_guard guard(interned_lock);
+		auto slot = Lookup(ptr);
+
+		if(!slot)
+			return;
+
+		auto it = interned.find(IdentityOf(*slot.value));
+		if(it != interned.end() && it->second.handle == ptr) {
+			if(--it->second.refs > 0)
+				return;
+
+			interned.erase(it);
+		}
+		handles.take((uintptr_t)ptr, released);
+	} catch(...) {}
+}
+
+// Drops the interned handles of the component with globalId and of every component below it.
+// Later calls with those handles fail the generation check instead of reaching a removed component
+static void ReleaseSubtree(const std::string& globalId)
+{
+	// destroyed after the lock is released
+	std::vector<SharedObjectPtr> released;
+
+	std::lock_guard guard(interned_lock);
+
+	const std::string prefix = globalId + "/";
+
+	for(auto it = interned.begin(); it != interned.end();) {
+		auto slot = Lookup(it->second.handle);
+		const auto component = slot ? slot.value->object.asPtrOrNull<daq::IComponent>(true) : daq::ComponentPtr();
+
+		if(component.assigned()) {
+			const std::string id = component.getGlobalId();
+			if(id == globalId || id.compare(0, prefix.size(), prefix) == 0) {
+				handles.take((uintptr_t)it->second.handle, released.emplace_back());
+				it = interned.erase(it);
+				continue;
+			}
+		}
+		++it;
+	}
 }
 
 int          OpenDaqObject_List    (DaqObjectPtr self, const char* type)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		return obj->list(type);
+		return slot.value->list(type);
 	} catch(...) {
 		return EC_GENERIC_ERROR;
 	}
 }
 
-static std::unordered_set<std::string> string_pool;
+// Keyed by the returned pointer, so two callers that got equal strings own separate copies
+static std::mutex string_pool_lock;
+static std::unordered_map<const char*, std::unique_ptr<std::string>> string_pool;
+
+static const char* PoolString(std::string&& str)
+{
+	auto owned = std::make_unique<std::string>(std::move(str));
+	auto ptr = owned->c_str();
+
+	std::lock_guard guard(string_pool_lock);
+	string_pool.emplace(ptr, std::move(owned));
+	return ptr;
+}
+
+// Copies str into caller memory. needed always receives the size including the terminator,
+// so passing cap = 0 queries the size without writing anything
+static int CopyToBuffer(const std::string& str, char* buf, uint64 cap, uint64* needed)
+{
+	const uint64 size = str.size() + 1;
+
+	if(needed)
+		*needed = size;
+
+	if(buf == nullptr || cap < size)
+		return EC_INSUFFICIENT_SIZE;
 
+	memcpy(buf, str.c_str(), size);
+	return EC_OK;
+}
 
 void         StringPool_Free       (const char* str)
 {
+	std::unique_ptr<std::string> released;
+	std::lock_guard guard(string_pool_lock);
+
 	auto it = string_pool.find(str);
 
-	if(it != string_pool.end())
+	if(it != string_pool.end()) {
+		released = std::move(it->second);
 		string_pool.erase(it);
+	}
 }
 
 const char*  OpenDaqObject_Get     (DaqObjectPtr self, const char* item)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return nullptr;
 
 	try {
-		const auto& [it, inserted] =
-			string_pool.emplace(obj->get(item));
-		return it->c_str();
+		return PoolString(slot.value->get(item));
 	} catch(...) {
 		return nullptr;
 	}
 }
 
+int          OpenDaqObject_GetToBuffer(DaqObjectPtr self, const char* item,
+									   char* buf, uint64 cap, uint64* needed)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	try {
+		return CopyToBuffer(slot.value->get(item), buf, cap, needed);
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+template <typename T>
+static int   GetTypedProperty(DaqObjectPtr self, const char* name, T& out)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || !name)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto prop = slot.value->object.asPtrOrNull<daq::IPropertyObject>();
+		if(prop.assigned()) {
+			return daq::AppPropertyObject::getValue(prop, name, out);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Property_GetDouble(DaqObjectPtr self, const char* name, double* out)
+{
+	if(!out)
+		return EC_INVALID_POINTER;
+
+	double value = 0;
+	int result = GetTypedProperty(self, name, value);
+
+	if(result == EC_OK)
+		*out = value;
+	return result;
+}
+
+int          Property_GetInt64(DaqObjectPtr self, const char* name, int64* out)
+{
+	if(!out)
+		return EC_INVALID_POINTER;
+
+	int64_t value = 0;
+	int result = GetTypedProperty(self, name, value);
+
+	if(result == EC_OK)
+		*out = value;
+	return result;
+}
+
+int          Property_GetBool(DaqObjectPtr self, const char* name, int* out)
+{
+	if(!out)
+		return EC_INVALID_POINTER;
+
+	bool value = false;
+	int result = GetTypedProperty(self, name, value);
+
+	if(result == EC_OK)
+		*out = value;
+	return result;
+}
+
+int          Property_GetString(DaqObjectPtr self, const char* name, char* buf, uint64 cap, uint64* needed)
+{
+	String value;
+	int result = GetTypedProperty(self, name, value);
+
+	return result == EC_OK ? CopyToBuffer(value, buf, cap, needed) : result;
+}
+
+template <typename T>
+static int   SetTypedProperty(DaqObjectPtr self, const char* name, T value)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || !name)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto prop = slot.value->object.asPtrOrNull<daq::IPropertyObject>();
+		if(prop.assigned()) {
+			return daq::AppPropertyObject::setValue(prop, name, value);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Property_SetDouble(DaqObjectPtr self, const char* name, double value)
+{
+	return SetTypedProperty(self, name, value);
+}
+
+int          Property_SetInt64(DaqObjectPtr self, const char* name, int64 value)
+{
+	return SetTypedProperty(self, name, (int64_t)value);
+}
+
+int          Property_SetBool(DaqObjectPtr self, const char* name, int value)
+{
+	return SetTypedProperty(self, name, value != 0);
+}
+
+int          OpenDaqObject_SetMany(DaqObjectPtr self, const char** names, const char** values, uint64 count)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || (count && (!names || !values)))
+		return EC_INVALID_POINTER;
+
+	// checked up front, so a bad entry does not leave the earlier ones applied
+	for(uint64 i = 0; i < count; ++i)
+		if(!names[i] || !values[i])
+			return EC_INVALID_POINTER;
+
+	try {
+		auto prop = slot.value->object.asPtrOrNull<daq::IPropertyObject>();
+		if(prop.assigned()) {
+			return daq::AppPropertyObject::setMany(prop, names, values, count);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
 int          OpenDaqObject_GetCount(DaqObjectPtr self, const char* itemArray)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		return obj->getCount(itemArray);
+		return slot.value->getCount(itemArray);
 	} catch(...) {
 		return EC_GENERIC_ERROR;
 	}
@@ -132,13 +477,13 @@ int          OpenDaqObject_GetCount(DaqObjectPtr self, const char* itemArray)
 
 int          OpenDaqObject_Set     (DaqObjectPtr self, const char* item, const char* value)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		return obj->set(item, value);
+		return slot.value->set(item, value);
 	} catch(...) {
 		return EC_GENERIC_ERROR;
 	}
@@ -146,15 +491,52 @@ int          OpenDaqObject_Set     (DaqObjectPtr self, const char* item, const c
 
 DaqObjectPtr OpenDaqObject_Select  (DaqObjectPtr self, const char* type, uint64 index)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
+
+	if(!slot || !type)
+		return nullptr;
+
+	try {
+		ObjectTag tag = ObjectTag::Unknown;
+		OpenDaqObjectPtr built;
+		auto object = daq::ComponentCache::Select(*slot.value, type, index, tag, &built);
+
+		return RegisterResolved(object, tag, std::move(built));
+	} catch(...) {
+		return nullptr;
+	}
+}
+
+DaqObjectPtr OpenDaqObject_Resolve (DaqObjectPtr root, const char* path)
+{
+	auto slot = Lookup(root);
+
+	if(!slot || !path)
+		return nullptr;
+
+	try {
+		ObjectTag tag = ObjectTag::Unknown;
+		OpenDaqObjectPtr built;
+		auto object = daq::ComponentCache::Resolve(*slot.value, path, tag, &built);
+
+		return RegisterResolved(object, tag, std::move(built));
+	} catch(...) {
+		return nullptr;
+	}
+}
+
+DaqObjectPtr OpenDaqObject_FindById(DaqObjectPtr root, const char* globalId)
+{
+	auto slot = Lookup(root);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot || !globalId)
 		return nullptr;
 
 	try {
-		const auto& [it, inserted] =
-			createdPtrs.emplace(obj->select(type, index));
-		return it->get();
+		ObjectTag tag = ObjectTag::Unknown;
+		auto object = daq::ComponentCache::FindById(*slot.value, globalId, tag);
+
+		return RegisterResolved(object, tag);
 	} catch(...) {
 		return nullptr;
 	}
@@ -162,12 +544,12 @@ DaqObjectPtr OpenDaqObject_Select  (DaqObjectPtr self, const char* type, uint64
 
 void         OpenDaqObject_Help    (DaqObjectPtr self)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj) || obj == nullptr)
-		obj = g_instance;
+	if(!slot)
+		slot = Lookup(g_instance);
 
-	if(obj) obj->help();
+	if(slot) slot.value->help();
 	else {
 		std::cout << help << std::endl;
 	}
@@ -175,18 +557,16 @@ void         OpenDaqObject_Help    (DaqObjectPtr self)
 
 const char* Device_GetAvailableDeviceConnectionString(DaqObjectPtr self, uint64 index)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return nullptr;
 
 	try {
-		auto device = dynamic_cast<daq::AppDevice*>(obj);
+		auto device = Cast<daq::AppDevice>(slot);
 
 		if(device) {
-			const auto& [it, inserted] =
-				string_pool.emplace(device->GetAvailableDeviceConnectionString(index));
-			return it->c_str();
+			return PoolString(device->GetAvailableDeviceConnectionString(index));
 		}
 		return nullptr;
 	} catch(...) {
@@ -196,18 +576,16 @@ const char* Device_GetAvailableDeviceConnectionString(DaqObjectPtr self, uint64
 
 const char* Device_GetAvailableFunctionBlockID(DaqObjectPtr self, uint64 index)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return nullptr;
 
 	try {
-		auto device = dynamic_cast<daq::AppDevice*>(obj);
+		auto device = Cast<daq::AppDevice>(slot);
 
 		if(device) {
-			const auto& [it, inserted] =
-				string_pool.emplace(device->GetAvailableFunctionBlockID(index));
-			return it->c_str();
+			return PoolString(device->GetAvailableFunctionBlockID(index));
 		}
 		return nullptr;
 	} catch(...) {
@@ -215,50 +593,617 @@ const char* Device_GetAvailableFunctionBlockID(DaqObjectPtr self, uint64 index)
 	}
 }
 
+int          Device_GetAvailableDeviceConnectionStringToBuffer(DaqObjectPtr self, uint64 index,
+															   char* buf, uint64 cap, uint64* needed)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto device = Cast<daq::AppDevice>(slot);
+
+		if(device) {
+			return CopyToBuffer(device->GetAvailableDeviceConnectionString(index), buf, cap, needed);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Device_GetAvailableFunctionBlockIDToBuffer(DaqObjectPtr self, uint64 index,
+														char* buf, uint64 cap, uint64* needed)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto device = Cast<daq::AppDevice>(slot);
+
+		if(device) {
+			return CopyToBuffer(device->GetAvailableFunctionBlockID(index), buf, cap, needed);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
 // Device specific methods. Work also for instance
 DaqObjectPtr Device_Add              (DaqObjectPtr self, const char* type, const char* value)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return nullptr;
+
+	try {
+		auto device = Cast<daq::AppDevice>(slot);
+		if(device) {
+			return Register(device->Add(type, value));
+		}
+		return nullptr;
+	} catch(...) {
+		return nullptr;
+	}
+}
+
+DaqObjectPtr Device_AddDevice        (DaqObjectPtr device, const char* connectionString)
+{
+	return Device_Add(device, "device", connectionString);
+}
+
+DaqObjectPtr Device_AddFunctionBlock (DaqObjectPtr device, const char* fbId)
+{
+	return Device_Add(device, "function-block", fbId);
+}
+
+int          Device_Remove           (DaqObjectPtr self, const char* type, uint64 index)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || !type)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto device = Cast<daq::AppDevice>(slot);
+		if(device) {
+			std::string globalId;
+			ObjectTag tag = ObjectTag::Unknown;
+			if(auto removed = daq::ComponentCache::Select(*slot.value, type, index, tag); removed.assigned())
+				if(auto component = removed.asPtrOrNull<daq::IComponent>(true); component.assigned())
+					globalId = component.getGlobalId();
+
+			const int result = device->Remove(type, index);
+
+			// the component and what it contains went away, so their handles do too, whatever
+			// refs are left on them. A failed remove leaves every handle valid
+			if(result == EC_OK && !globalId.empty())
+				ReleaseSubtree(globalId);
+
+			return result;
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Device_RemoveDevice     (DaqObjectPtr device, uint64 index)
+{
+	return Device_Remove(device, "device", index);
+}
+
+int          Device_RemoveFunctionBlock(DaqObjectPtr device, uint64 index)
+{
+	return Device_Remove(device, "function-block", index);
+}
+
+int          Device_LoadConfiguration(DaqObjectPtr self, const char* json)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto device = Cast<daq::AppDevice>(slot);
+		if(device) {
+			return device->LoadConfiguration(json);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+int          Device_LoadConfigurationFromFile(DaqObjectPtr device, const char* json_path)
+{
+	try {
+		auto str = read_file(json_path);
+
+		return Device_LoadConfiguration(device, str.c_str());
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+const char*  Device_SaveConfiguration(DaqObjectPtr self)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return nullptr;
+
+	try {
+		auto device = Cast<daq::AppDevice>(slot);
+		if(device) {
+			return PoolString(device->SaveConfiguration());
+		}
+		return nullptr;
+	} catch(...) {
+		return nullptr;
+	}
+}
+int          Device_SaveConfigurationToBuffer(DaqObjectPtr self, char* buf, uint64 cap, uint64* needed)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto device = Cast<daq::AppDevice>(slot);
+		if(device) {
+			return CopyToBuffer(device->SaveConfiguration(), buf, cap, needed);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Device_Snapshot(DaqObjectPtr self, unsigned int flags, char* buf, uint64 cap, uint64* needed)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto device = Cast<daq::AppDevice>(slot);
+		if(device) {
+			return CopyToBuffer(device->Snapshot(flags), buf, cap, needed);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Device_SaveConfigurationToFile(DaqObjectPtr device, const char* json_path)
+{
+	auto slot = Lookup(device);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	auto dev = Cast<daq::AppDevice>(slot);
+	if(!dev)
+		return EC_OBJECT_TYPE_MISMATCH;
+
+	try {
+		std::ofstream out(json_path);
+		out << dev->SaveConfiguration();
+
+		return out.good() ? EC_OK : EC_IO_ERROR;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          InputPort_Connect(DaqObjectPtr self, const char* signalid, DaqObjectPtr instance_device)
+{
+	auto slot = Lookup(self);
+	auto slot2 = Lookup(instance_device);
+	if(!slot || !slot2)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto port = Cast<daq::AppInputPort>(slot);
+		auto instance = Cast<daq::AppDevice>(slot2);
+		if(port && instance) {
+			return port->connect(signalid, instance->object);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          InputPort_ConnectMany(DaqObjectPtr* ports, const char** signalids, uint64 count, DaqObjectPtr instance_device)
+{
+	auto slot = Lookup(instance_device);
+	if(!slot || (count && (!ports || !signalids)))
+		return EC_INVALID_POINTER;
+
+	try {
+		auto instance = Cast<daq::AppDevice>(slot);
+		if(!instance)
+			return EC_OBJECT_TYPE_MISMATCH;
+
+		// all IDs are resolved before connecting anything: connecting may add signals,
+		// which would rebuild the index halfway through
+		std::vector<daq::SignalPtr> signals(count);
+		for(uint64 i = 0; i < count; ++i)
+			signals[i] = daq::ComponentCache::FindSignal(instance->object, signalids[i]);
+
+		int result = EC_OK;
+		for(uint64 i = 0; i < count; ++i) {
+			auto portSlot = Lookup(ports[i]);
+			auto port = Cast<daq::AppInputPort>(portSlot);
+			int error;
+
+			if(!portSlot)
+				error = EC_INVALID_POINTER;
+			else if(!port)
+				error = EC_OBJECT_TYPE_MISMATCH;
+			else if(!signals[i].assigned())
+				error = EC_SIGNAL_ID_INVALID;
+			else {
+				try {
+					error = port->connect(signals[i]);
+				} catch(...) {
+					error = EC_GENERIC_ERROR;
+				}
+			}
+
+			if(result == EC_OK)
+				result = error;
+		}
+		return result;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          InputPort_Disconnect(DaqObjectPtr self)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto port = Cast<daq::AppInputPort>(slot);
+		if(port) {
+			return port->disconnect();
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+
+int          Signal_Read(DaqObjectPtr self, uint64 NumOfSamples, int timeout)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->Read(NumOfSamples, timeout);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_ReadInto(DaqObjectPtr self, double* values, int64* timestamps, uint64 count, int timeout)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || (count && !values))
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->ReadInto(values, (int64_t*)timestamps, count, timeout);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_ReadTicksInto(DaqObjectPtr self, double* values, int64* ticks, uint64 count, int timeout)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || (count && !values))
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->ReadTicksInto(values, (int64_t*)ticks, count, timeout);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_GetDomainInfo(DaqObjectPtr self, TickDomain* info)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || !info)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->GetDomainInfo(*info);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_TicksToTime(DaqObjectPtr self, const int64* ticks, int64* times, uint64 count)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || (count && (!ticks || !times)))
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->TicksToTime((const int64_t*)ticks, (int64_t*)times, count);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_ReadLinear(DaqObjectPtr self, double* values, uint64 count, int timeout,
+                              TimeAxis* axis, TimeBreak* breaks, uint64 maxBreaks)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || !axis || (count && !values))
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->ReadLinear(values, count, timeout, *axis, breaks, breaks ? maxBreaks : 0);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_ReadEnvelope(DaqObjectPtr self, uint64 count, uint64 bins, double* min, double* max,
+								 double* first, double* last, int64* binTimes, int timeout)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || !min || !max)
+		return EC_INVALID_POINTER;
+
+	if(bins == 0)
+		return EC_INSUFFICIENT_SIZE;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->ReadEnvelope(count, bins, min, max, first, last, (int64_t*)binTimes, timeout);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_ReadStats(DaqObjectPtr self, uint64 count, int timeout, BlockStats* stats)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || !stats)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->ReadStats(count, timeout, *stats);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_SetReadFormat(DaqObjectPtr self, int sampleType, int raw)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->SetReadFormat(sampleType, raw != 0);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_ReadTypedInto(DaqObjectPtr self, void* values, int64* timestamps, uint64 count, int timeout)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || (count && !values))
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->ReadTypedInto(values, (int64_t*)timestamps, count, timeout);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_GetScaling(DaqObjectPtr self, double* scale, double* offset)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || !scale || !offset)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->GetScaling(*scale, *offset);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_StartAcquisition(DaqObjectPtr self, uint64 ringCapacity)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->StartAcquisition(ringCapacity);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_StopAcquisition(DaqObjectPtr self)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->StopAcquisition();
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_Drain(DaqObjectPtr self, double* values, int64* timestamps, uint64 max)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || (max && !values))
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->Drain(values, (int64_t*)timestamps, max);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_GetAcquisitionStats(DaqObjectPtr self, uint64* available, uint64* highWater, uint64* overruns)
+{
+	auto slot = Lookup(self);
+
+	if(!slot || !available || !highWater || !overruns)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			uint64_t a, h, o;
+			int result = signal->GetAcquisitionStats(a, h, o);
+
+			if(result == EC_OK) {
+				*available = a;
+				*highWater = h;
+				*overruns = o;
+			}
+			return result;
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int          Signal_SetReadTimeoutMode(DaqObjectPtr self, int mode)
+{
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
-		return nullptr;
+	if(!slot)
+		return EC_INVALID_POINTER;
 
 	try {
-		auto device = dynamic_cast<daq::AppDevice*>(obj);
-		if(device) {
-			const auto& [it, inserted] =
-				createdPtrs.emplace(device->Add(type, value));
-			return it->get();
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->SetReadTimeoutMode(mode);
 		}
-		return nullptr;
+		return EC_OBJECT_TYPE_MISMATCH;
 	} catch(...) {
-		return nullptr;
+		return EC_GENERIC_ERROR;
 	}
 }
 
-DaqObjectPtr Device_AddDevice        (DaqObjectPtr device, const char* connectionString)
-{
-	return Device_Add(device, "device", connectionString);
-}
-
-DaqObjectPtr Device_AddFunctionBlock (DaqObjectPtr device, const char* fbId)
-{
-	return Device_Add(device, "function-block", fbId);
-}
-
-int          Device_Remove           (DaqObjectPtr self, const char* type, uint64 index)
+int          Signal_GetAvailableCount(DaqObjectPtr self, uint64* count)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot || !count)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto device = dynamic_cast<daq::AppDevice*>(obj);
-		if(device) {
-			OpenDaqObject_Free(obj->select(type, index).get());
-
-			return device->Remove(type, index);
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			uint64_t available = 0;
+			const int result = signal->GetAvailableCount(available);
+			*count = available;
+			return result;
 		}
 		return EC_OBJECT_TYPE_MISMATCH;
 	} catch(...) {
@@ -266,98 +1211,114 @@ int          Device_Remove           (DaqObjectPtr self, const char* type, uint6
 	}
 }
 
-int          Device_RemoveDevice     (DaqObjectPtr device, uint64 index)
+int          Signal_GetReadInfo(DaqObjectPtr self, ReadInfo* info)
 {
-	return Device_Remove(device, "device", index);
-}
+	auto slot = Lookup(self);
 
-int          Device_RemoveFunctionBlock(DaqObjectPtr device, uint64 index)
-{
-	return Device_Remove(device, "function-block", index);
+	if(!slot || !info)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->GetReadInfo(*info);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
 }
 
-int          Device_LoadConfiguration(DaqObjectPtr self, const char* json)
+int          Signal_GetDimensions(DaqObjectPtr self, uint64* elements, double* labels, uint64 cap)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot || !elements)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto device = dynamic_cast<daq::AppDevice*>(obj);
-		if(device) {
-			return device->LoadConfiguration(json);
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			uint64_t count = 0;
+			const int result = signal->GetDimensions(count, labels, cap);
+			*elements = count;
+			return result;
 		}
 		return EC_OBJECT_TYPE_MISMATCH;
 	} catch(...) {
 		return EC_GENERIC_ERROR;
 	}
 }
-int          Device_LoadConfigurationFromFile(DaqObjectPtr device, const char* json_path)
+
+int          Signal_ReadVectors(DaqObjectPtr self, double* values, int64* timestamps, uint64 count, int timeout)
 {
-	try {
-		auto str = read_file(json_path);
+	auto slot = Lookup(self);
 
-		return Device_LoadConfiguration(device, str.c_str());
+	if(!slot || (count && !values))
+		return EC_INVALID_POINTER;
+
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->ReadVectors(values, (int64_t*)timestamps, count, timeout);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
 	} catch(...) {
 		return EC_GENERIC_ERROR;
 	}
 }
 
-const char*  Device_SaveConfiguration(DaqObjectPtr self)
+int          Signal_GetStructLayout(DaqObjectPtr self, StructField* fields, uint64 cap, uint64* count, uint64* recordSize)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
-		return nullptr;
+	if(!slot || !count || !recordSize)
+		return EC_INVALID_POINTER;
 
 	try {
-		auto device = dynamic_cast<daq::AppDevice*>(obj);
-		if(device) {
-			const auto& [it, inserted] =
-				string_pool.emplace(device->SaveConfiguration());
-			return it->c_str();
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			uint64_t fieldCount = 0, size = 0;
+			const int result = signal->GetStructLayout(fields, cap, fieldCount, size);
+			*count = fieldCount;
+			*recordSize = size;
+			return result;
 		}
-		return nullptr;
+		return EC_OBJECT_TYPE_MISMATCH;
 	} catch(...) {
-		return nullptr;
+		return EC_GENERIC_ERROR;
 	}
 }
-int          Device_SaveConfigurationToFile(DaqObjectPtr device, const char* json_path)
+
+int          Signal_ReadStructs(DaqObjectPtr self, void* records, int64* timestamps, uint64 count, int timeout)
 {
-	auto obj = (OpenDaqObject*)device;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot || (count && !records))
 		return EC_INVALID_POINTER;
 
-	if(!dynamic_cast<daq::AppDevice*>(obj))
+	try {
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->ReadStructs(records, (int64_t*)timestamps, count, timeout);
+		}
 		return EC_OBJECT_TYPE_MISMATCH;
-
-	auto str = Device_SaveConfiguration(device);
-
-	if(str) {
-		std::ofstream out(json_path);
-		out << str;
-
-		return out.good() ? EC_OK : EC_IO_ERROR;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
 	}
-
-	return EC_GENERIC_ERROR;
 }
 
-int          InputPort_Connect(DaqObjectPtr self, const char* signalid, DaqObjectPtr instance_device)
+int          Signal_BorrowStructs(DaqObjectPtr self, const void** records, int64* timestamps, uint64 count, int timeout)
 {
-	auto obj = (OpenDaqObject*)self;
-	auto obj2 = (OpenDaqObject*)instance_device;
-	if(!contains_uptr(createdPtrs, obj) 	||
-	   !contains_uptr(createdPtrs, obj2))
+	auto slot = Lookup(self);
+
+	if(!slot || !records)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto port = dynamic_cast<daq::AppInputPort*>(obj);
-		auto instance = dynamic_cast<daq::AppDevice*>(obj2);
-		if(port) {
-			return port->connect(signalid, instance->object);
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->BorrowStructs(*records, (int64_t*)timestamps, count, timeout);
 		}
 		return EC_OBJECT_TYPE_MISMATCH;
 	} catch(...) {
@@ -365,17 +1326,17 @@ int          InputPort_Connect(DaqObjectPtr self, const char* signalid, DaqObjec
 	}
 }
 
-int          InputPort_Disconnect(DaqObjectPtr self)
+int          Signal_ReleaseStructs(DaqObjectPtr self)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto port = dynamic_cast<daq::AppInputPort*>(obj);
-		if(port) {
-			return port->disconnect();
+		auto signal = Cast<daq::AppSignal>(slot);
+		if(signal) {
+			return signal->ReleaseStructs();
 		}
 		return EC_OBJECT_TYPE_MISMATCH;
 	} catch(...) {
@@ -383,18 +1344,17 @@ int          InputPort_Disconnect(DaqObjectPtr self)
 	}
 }
 
-
-int          Signal_Read(DaqObjectPtr self, uint64 NumOfSamples, int timeout)
+int          Signal_SetDataCallback(DaqObjectPtr self, DataCallback fn, void* user, uint64 minSamples)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto signal = dynamic_cast<daq::AppSignal*>(obj);
+		auto signal = Cast<daq::AppSignal>(slot);
 		if(signal) {
-			return signal->Read(NumOfSamples, timeout);
+			return signal->SetDataCallback(fn, user, minSamples);
 		}
 		return EC_OBJECT_TYPE_MISMATCH;
 	} catch(...) {
@@ -405,14 +1365,16 @@ int          Signal_Read(DaqObjectPtr self, uint64 NumOfSamples, int timeout)
 
 double*      Signal_GetSampleReadings(DaqObjectPtr self)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return nullptr;
 
 	try {
-		auto signal = dynamic_cast<daq::AppSignal*>(obj);
+		auto signal = Cast<daq::AppSignal>(slot);
 		if(signal) {
+			std::lock_guard guard(signal->samplesLock);
+
 			if(signal->samples.readCount == SampleData::uninitialized)
 				return nullptr;
 
@@ -426,14 +1388,16 @@ double*      Signal_GetSampleReadings(DaqObjectPtr self)
 
 int64*       Signal_GetSampleTimeStamps(DaqObjectPtr self)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return nullptr;
 
 	try {
-		auto signal = dynamic_cast<daq::AppSignal*>(obj);
+		auto signal = Cast<daq::AppSignal>(slot);
 		if(signal) {
+			std::lock_guard guard(signal->samplesLock);
+
 			if(signal->samples.readCount == SampleData::uninitialized)
 				return nullptr;
 
@@ -447,14 +1411,16 @@ int64*       Signal_GetSampleTimeStamps(DaqObjectPtr self)
 
 int          Signal_GetSampleCountOfRead(DaqObjectPtr self)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto signal = dynamic_cast<daq::AppSignal*>(obj);
+		auto signal = Cast<daq::AppSignal>(slot);
 		if(signal) {
+			std::lock_guard guard(signal->samplesLock);
+
 			auto readCount = signal->samples.readCount;
 
 			return
@@ -470,14 +1436,16 @@ int          Signal_GetSampleCountOfRead(DaqObjectPtr self)
 
 int          Signal_EraseSamples(DaqObjectPtr self)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto signal = dynamic_cast<daq::AppSignal*>(obj);
+		auto signal = Cast<daq::AppSignal>(slot);
 		if(signal) {
+			std::lock_guard guard(signal->samplesLock);
+
 			return (signal->samples.Erase(), EC_OK);
 		}
 		return EC_OBJECT_TYPE_MISMATCH;
@@ -488,14 +1456,16 @@ int          Signal_EraseSamples(DaqObjectPtr self)
 
 int          Signal_GetSampleReadingsToArray(DaqObjectPtr self, double* array, uint64 len)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto signal = dynamic_cast<daq::AppSignal*>(obj);
+		auto signal = Cast<daq::AppSignal>(slot);
 		if(signal) {
+			std::lock_guard guard(signal->samplesLock);
+
 			if(signal->samples.readCount == SampleData::uninitialized)
 				return EC_UNINITIALIZED;
 
@@ -514,14 +1484,16 @@ int          Signal_GetSampleReadingsToArray(DaqObjectPtr self, double* array, u
 
 int          Signal_GetSampleTimeStampsToArray(DaqObjectPtr self, int64* array, uint64 len)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto signal = dynamic_cast<daq::AppSignal*>(obj);
+		auto signal = Cast<daq::AppSignal>(slot);
 		if(signal) {
+			std::lock_guard guard(signal->samplesLock);
+
 			if(signal->samples.readCount == SampleData::uninitialized)
 				return EC_UNINITIALIZED;
 
@@ -566,13 +1538,13 @@ const char*  TimeStampToString(int64 timestamp)
 
 int          Signal_SendDataPacket(DaqObjectPtr self, double* data, uint64 count)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto signal = dynamic_cast<daq::AppSignal*>(obj);
+		auto signal = Cast<daq::AppSignal>(slot);
 		if(signal) {
 			return (signal->SendDataPacket(data, count), EC_OK);
 		}
@@ -584,13 +1556,13 @@ int          Signal_SendDataPacket(DaqObjectPtr self, double* data, uint64 count
 
 int          Signal_SendTestDataPacket(DaqObjectPtr self, uint64 count, double sine_range)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto signal = dynamic_cast<daq::AppSignal*>(obj);
+		auto signal = Cast<daq::AppSignal>(slot);
 		if(signal) {
 			return (signal->SendTestDataPacket(count, sine_range), EC_OK);
 		}
@@ -602,16 +1574,13 @@ int          Signal_SendTestDataPacket(DaqObjectPtr self, uint64 count, double s
 
 int          OpenDaqObject_Print   (DaqObjectPtr self, const char* item)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		if((obj = dynamic_cast<OpenDaqObject*>(obj)) != nullptr) {
-			return obj->print(item);
-		}
-		return EC_OBJECT_TYPE_MISMATCH;
+		return slot.value->print(item);
 	} catch(...) {
 		return EC_GENERIC_ERROR;
 	}
@@ -619,13 +1588,13 @@ int          OpenDaqObject_Print   (DaqObjectPtr self, const char* item)
 
 EXPORTFUN int          Signal_LoadDataDescriptorFromJson(DaqObjectPtr self, const char* json)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
 	try {
-		auto signal = dynamic_cast<daq::AppSignal*>(obj);
+		auto signal = Cast<daq::AppSignal>(slot);
 		if(signal) {
 			return signal->LoadDataDescriptorFromJson(json);
 		}
@@ -647,17 +1616,15 @@ EXPORTFUN int          Signal_LoadDataDescriptorFromJsonFile(DaqObjectPtr signal
 
 EXPORTFUN const char*  DataDescriptor_SaveToJson(DaqObjectPtr self)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return nullptr;
 
 	try {
-		auto desc = dynamic_cast<daq::AppDescriptor*>(obj);
+		auto desc = Cast<daq::AppDescriptor>(slot);
 		if(desc) {
-			const auto& [it, inserted] =
-				string_pool.emplace(desc->SaveConfiguration());
-			return it->c_str();
+			return PoolString(desc->SaveConfiguration());
 		}
 		return nullptr;
 	} catch(...) {
@@ -666,66 +1633,91 @@ EXPORTFUN const char*  DataDescriptor_SaveToJson(DaqObjectPtr self)
 }
 EXPORTFUN int          DataDescriptor_SaveToJsonFile(DaqObjectPtr self, const char* path)
 {
-	auto obj = (OpenDaqObject*)self;
+	auto slot = Lookup(self);
 
-	if(!contains_uptr(createdPtrs, obj))
+	if(!slot)
 		return EC_INVALID_POINTER;
 
-	if(!dynamic_cast<daq::AppDescriptor*>(obj))
+	auto desc = Cast<daq::AppDescriptor>(slot);
+	if(!desc)
 		return EC_OBJECT_TYPE_MISMATCH;
 
-	auto str = DataDescriptor_SaveToJson(self);
-
-	if(str) {
+	try {
 		std::ofstream out(path);
-		out << str;
+		out << desc->SaveConfiguration();
 
 		return out.good() ? EC_OK : EC_IO_ERROR;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
 	}
+}
+
+EXPORTFUN int          DataDescriptor_SaveToJsonToBuffer(DaqObjectPtr self, char* buf, uint64 cap, uint64* needed)
+{
+	auto slot = Lookup(self);
+
+	if(!slot)
+		return EC_INVALID_POINTER;
 
-	return EC_GENERIC_ERROR;
+	try {
+		auto desc = Cast<daq::AppDescriptor>(slot);
+		if(desc) {
+			return CopyToBuffer(desc->SaveConfiguration(), buf, cap, needed);
+		}
+		return EC_OBJECT_TYPE_MISMATCH;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
 }
 
+// Multi-reader IDs are slot map handles like object handles, so unbinding one reader leaves
+// the IDs of the others alone and a stale ID never reaches a reader bound later in its slot.
+// bound_signals_lock only guards bound_signals, each reader has its own lock
+static std::mutex bound_signals_lock;
 static std::unordered_set<void*> bound_signals;
-static std::deque<BoundMultiReader> multireaders;
+static ShardedSlotMap<std::shared_ptr<BoundMultiReader>> multireaders;
 
-int64 MultiReader_Bind(DaqObjectPtrArray signals, uint64 NumOfSignals)
+static int64 BindMultiReader(DaqObjectPtrArray signals, uint64 NumOfSignals, bool ticks)
 {
+	std::lock_guard lock(bound_signals_lock);
+	std::vector<HandleRef> refs;
+	refs.reserve(NumOfSignals);
+
 	// Validation loop
 	for(auto i = 0u; i < NumOfSignals; ++i) {
-		auto obj = (OpenDaqObject*)signals[i];
+		auto slot = Lookup(signals[i]);
 
-		if(!contains_uptr(createdPtrs, obj))
+		if(!slot)
 			return EC_INVALID_POINTER;
 
-		auto signal = dynamic_cast<daq::AppSignal*>(obj);
+		auto signal = Cast<daq::AppSignal>(slot);
 
 		if(!signal)
 			return EC_OBJECT_TYPE_MISMATCH;
 
-		if(bound_signals.find(obj) != bound_signals.end()) {
+		if(bound_signals.find(signals[i]) != bound_signals.end()) {
 			std::cout << "Signal[" << i << "] at "
-					  << std::hex  << (void*)obj
+					  << std::hex  << signals[i]
 					  << " is already bound to MultiReader" << std::endl;
 			return EC_SIGNAL_IS_ALREADY_BOUND;
 		}
+		refs.push_back(std::move(slot));
 	}
 
 	try {
 		auto buffer = daq::List<daq::ISignal>();
 		// fill the buffer loop
 		for(auto i = 0u; i < NumOfSignals; ++i) {
-			auto obj = (OpenDaqObject*)signals[i];
-			bound_signals.insert(obj);
+			bound_signals.insert(signals[i]);
 
-			buffer.pushBack(obj->object.asPtr<daq::ISignal>());
+			buffer.pushBack(refs[i].value->object.asPtr<daq::ISignal>());
 		}
 
-		BoundMultiReader bound(buffer, signals);
-		daq::AppSignal::MultiReaderFirstNullRead(bound, NumOfSignals);
+		auto bound = std::make_shared<BoundMultiReader>(buffer, signals, ticks);
+		daq::AppSignal::MultiReaderFirstNullRead(*bound, NumOfSignals);
 
-		multireaders.emplace_back(std::move(bound));
-		return multireaders.size() - 1;
+		// generations stay within 31 bits, so an ID is always positive
+		return static_cast<int64>(multireaders.insert(std::move(bound)));
 	} catch(...) {
 		// if exception occurred remove the signals from the bound set
 		for(auto i = 0u; i < NumOfSignals; ++i) {
@@ -735,28 +1727,248 @@ int64 MultiReader_Bind(DaqObjectPtrArray signals, uint64 NumOfSignals)
 	}
 }
 
+int64 MultiReader_Bind(DaqObjectPtrArray signals, uint64 NumOfSignals)
+{
+	return BindMultiReader(signals, NumOfSignals, false);
+}
+
+int64 MultiReader_BindTicks(DaqObjectPtrArray signals, uint64 NumOfSignals)
+{
+	return BindMultiReader(signals, NumOfSignals, true);
+}
+
 int MultiReader_UnBind(int64 multiReaderId)
 {
-	try {
-		const auto& multiReader = multireaders.at(multiReaderId);
+	// destroyed after the locks are released; a read still running holds its own reference
+	std::shared_ptr<BoundMultiReader> released;
 
-		for(void* const signal : multiReader.signals) {
-			bound_signals.erase(signal);
-		}
+	if(multiReaderId <= 0 || !multireaders.take((uint64_t)multiReaderId, released))
+		return EC_OK;
 
-		multireaders.erase(multireaders.begin() + multiReaderId);
-	} catch(...) {}
+	std::lock_guard lock(bound_signals_lock);
+	for(void* const signal : released->signals) {
+		bound_signals.erase(signal);
+	}
 	return EC_OK;
 }
 
+// Unknown and stale IDs throw std::out_of_range, which the exports turn into EC_ARRAY_OUT_OF_BOUNDS
+static std::shared_ptr<BoundMultiReader> FindMultiReader(int64 multiReaderId)
+{
+	std::shared_ptr<BoundMultiReader> multiReader;
+	uint32_t tag;
+
+	if(multiReaderId <= 0 || !multireaders.find((uint64_t)multiReaderId, multiReader, tag))
+		throw std::out_of_range("multi reader");
+
+	return multiReader;
+}
+
+int MultiReader_SetReadTimeoutMode(int64 multiReaderId, int mode)
+{
+	try {
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
+
+		return daq::AppSignal::SetMultiReadTimeoutMode(*multiReader, mode);
+	} catch(const std::out_of_range&) {
+		return EC_ARRAY_OUT_OF_BOUNDS;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int MultiReader_GetAvailableCount(int64 multiReaderId, uint64* count)
+{
+	if(!count)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
+
+		*count = multiReader->multireader.getAvailableCount();
+		return EC_OK;
+	} catch(const std::out_of_range&) {
+		return EC_ARRAY_OUT_OF_BOUNDS;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int MultiReader_GetReadInfo(int64 multiReaderId, ReadInfo* info)
+{
+	if(!info)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
+
+		daq::AppSignal::TakeReadInfo(multiReader->lastRead, *info);
+		return EC_OK;
+	} catch(const std::out_of_range&) {
+		return EC_ARRAY_OUT_OF_BOUNDS;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int MultiReader_SetDataCallback(int64 multiReaderId, DataCallback fn, void* user, uint64 minSamples)
+{
+	try {
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
+
+		daq::AppSignal::SetMultiDataCallback(*multiReader, fn, user, minSamples);
+		return EC_OK;
+	} catch(const std::out_of_range&) {
+		return EC_ARRAY_OUT_OF_BOUNDS;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int MultiReader_SetReadFormat(int64 multiReaderId, int sampleType, int raw)
+{
+	try {
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
+
+		return daq::AppSignal::SetMultiReadFormat(*multiReader, sampleType, raw != 0);
+	} catch(const std::out_of_range&) {
+		return EC_ARRAY_OUT_OF_BOUNDS;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int MultiReader_ReadTypedToArrays(int64 multiReaderId,
+								  uint64 NumOfSamples, int timeout,
+								  void** data, int64** timestamps)
+{
+	if(!data)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
+
+		return daq::AppSignal::ReadMultiTyped(*multiReader, NumOfSamples, timeout, data, (int64_t**)timestamps);
+	} catch(const std::out_of_range&) {
+		return EC_ARRAY_OUT_OF_BOUNDS;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
 int MultiReader_ReadToArrays(int64 multiReaderId,
 							 uint64 NumOfSamples, int timeout,
 							 double** data, int64** timestamps)
 {
 	try {
-		const auto& multiReader = multireaders.at(multiReaderId);
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
+
+		return daq::AppSignal::ReadMulti(*multiReader, NumOfSamples, timeout, data, (int64_t**)timestamps);
+	} catch(const std::out_of_range&) {
+		return EC_ARRAY_OUT_OF_BOUNDS;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int MultiReader_ReadEnvelope(int64 multiReaderId,
+							 uint64 NumOfSamples, uint64 bins, int timeout,
+							 double** min, double** max, double** first, double** last, int64* binTimes)
+{
+	if(!min || !max)
+		return EC_INVALID_POINTER;
+
+	if(bins == 0)
+		return EC_INSUFFICIENT_SIZE;
+
+	try {
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
+
+		return daq::AppSignal::ReadMultiEnvelope(*multiReader, NumOfSamples, bins, timeout,
+												 min, max, first, last, (int64_t*)binTimes);
+	} catch(const std::out_of_range&) {
+		return EC_ARRAY_OUT_OF_BOUNDS;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int MultiReader_ReadShared(int64 multiReaderId,
+						   uint64 NumOfSamples, int timeout,
+						   double** data, int64* timestamps)
+{
+	if(!data)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
+
+		return daq::AppSignal::ReadMultiShared(*multiReader, NumOfSamples, timeout, data, (int64_t*)timestamps);
+	} catch(const std::out_of_range&) {
+		return EC_ARRAY_OUT_OF_BOUNDS;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int MultiReader_ReadToBuffer(int64 multiReaderId,
+							 uint64 NumOfSamples, int timeout,
+							 int layout, uint64 stride, double* data, int64* timestamps)
+{
+	if(!data)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
+
+		return daq::AppSignal::ReadMultiToBuffer(*multiReader, NumOfSamples, timeout, layout, stride, data, (int64_t*)timestamps);
+	} catch(const std::out_of_range&) {
+		return EC_ARRAY_OUT_OF_BOUNDS;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int MultiReader_ReadStats(int64 multiReaderId, uint64 NumOfSamples, int timeout, BlockStats* stats)
+{
+	if(!stats)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
+
+		return daq::AppSignal::ReadMultiStats(*multiReader, NumOfSamples, timeout, stats);
+	} catch(const std::out_of_range&) {
+		return EC_ARRAY_OUT_OF_BOUNDS;
+	} catch(...) {
+		return EC_GENERIC_ERROR;
+	}
+}
+
+int MultiReader_ReadLinear(int64 multiReaderId,
+						   uint64 NumOfSamples, int timeout,
+						   double** data, TimeAxis* axis, TimeBreak* breaks, uint64 maxBreaks)
+{
+	if(!axis || !data)
+		return EC_INVALID_POINTER;
+
+	try {
+		auto multiReader = FindMultiReader(multiReaderId);
+		std::lock_guard guard(multiReader->lock);
 
-		return daq::AppSignal::ReadMulti(multiReader, NumOfSamples, timeout, data, (int64_t**)timestamps);
+		return daq::AppSignal::ReadMultiLinear(*multiReader, NumOfSamples, timeout, data,
+											   *axis, breaks, breaks ? maxBreaks : 0);
 	} catch(const std::out_of_range&) {
 		return EC_ARRAY_OUT_OF_BOUNDS;
 	} catch(...) {
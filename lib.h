@@ -1,4 +1,5 @@
 #pragma once
+#include "AbiTypes.h"
 
 #if defined(_WIN32) || defined(__WIN32__)
 #define  EXPORTFUN extern "C" __declspec(dllexport)
@@ -15,6 +16,14 @@ typedef void** DaqObjectPtrArray;
 typedef unsigned long long uint64;
 typedef long long int64;
 
+// Called on the thread that delivered the packet; available is the number of samples queued
+typedef void (*DataCallback)(void* user, uint64 available);
+
+// Threading: every function may be called from several threads at once.
+// Objects stay valid for the duration of a call even if another thread frees
+// their handle. Pointers returned by Signal_GetSampleReadings/TimeStamps are
+// only valid until the next read on that signal.
+
 // Stdout manip
 EXPORTFUN void         StdOut_PipeToString     (void);
 EXPORTFUN const char*  StdOut_GetBufferString  (void);
@@ -24,17 +33,44 @@ EXPORTFUN void         StdOut_EraseBuffer      (void);
 // free any string returned by this dll
 EXPORTFUN void         StringPool_Free       (const char* str);
 
+// *_ToBuffer variants write straight into caller memory and keep nothing allocated.
+// needed receives the size including the terminator; if cap is too small nothing is
+// written and EC_INSUFFICIENT_SIZE is returned, so buf = NULL, cap = 0 queries the size.
+
 EXPORTFUN DaqObjectPtr Instance_New          (void);
 
 // Polymorphic methods:
+// Selecting the same component again returns the same handle; every Select/Add needs its own Free
 EXPORTFUN void         OpenDaqObject_Free    (DaqObjectPtr self);
 EXPORTFUN int          OpenDaqObject_Print   (DaqObjectPtr self, const char* item); // outputs to console
 EXPORTFUN int          OpenDaqObject_List    (DaqObjectPtr self, const char* type); // outputs to console
 EXPORTFUN const char*  OpenDaqObject_Get     (DaqObjectPtr self, const char* item);
+EXPORTFUN int          OpenDaqObject_GetToBuffer(DaqObjectPtr self, const char* item, char* buf, uint64 cap, uint64* needed);
 EXPORTFUN int          OpenDaqObject_GetCount(DaqObjectPtr self, const char* itemArray);
 EXPORTFUN int          OpenDaqObject_Set     (DaqObjectPtr self, const char* item, const char* value);
+// Applies all values in one beginUpdate/endUpdate transaction. EC_INVALID_POINTER for NULL
+// arrays or entries, EC_CONVERSION_FAILED when a value does not parse for its property and
+// EC_PROPERTY_READ_ONLY for read-only ones; the other values are still applied
+EXPORTFUN int          OpenDaqObject_SetMany (DaqObjectPtr self, const char** items, const char** values, uint64 count);
 EXPORTFUN DaqObjectPtr OpenDaqObject_Select  (DaqObjectPtr self, const char* type, uint64 index);
+// Walks a "device/0/channel/3/signal/0" path (select types, "dev"/"fb" accepted, a missing
+// index means 0) in one call. Results are cached until components are added or removed
+EXPORTFUN DaqObjectPtr OpenDaqObject_Resolve (DaqObjectPtr root, const char* path);
+// Looks a component up by its global ID, e.g. as returned by OpenDaqObject_Get(signal, "id")
+EXPORTFUN DaqObjectPtr OpenDaqObject_FindById(DaqObjectPtr root, const char* globalId);
 EXPORTFUN void         OpenDaqObject_Help    (DaqObjectPtr self); // nullptr will call help on instance
+
+// Typed property reads. They read the value directly and never print to or redirect stdout.
+// EC_INVALID_POINTER for a NULL name or out
+EXPORTFUN int          Property_GetDouble    (DaqObjectPtr self, const char* name, double* out);
+EXPORTFUN int          Property_GetInt64     (DaqObjectPtr self, const char* name, int64* out);
+EXPORTFUN int          Property_GetBool      (DaqObjectPtr self, const char* name, int* out);
+EXPORTFUN int          Property_GetString    (DaqObjectPtr self, const char* name, char* buf, uint64 cap, uint64* needed);
+
+// Typed property writes, converted to the property's value type without EvalValue
+EXPORTFUN int          Property_SetDouble    (DaqObjectPtr self, const char* name, double value);
+EXPORTFUN int          Property_SetInt64     (DaqObjectPtr self, const char* name, int64 value);
+EXPORTFUN int          Property_SetBool      (DaqObjectPtr self, const char* name, int value);
 // Device specific methods. Work also for instance
 EXPORTFUN DaqObjectPtr Device_Add              (DaqObjectPtr device, const char* type, const char* value);
 EXPORTFUN DaqObjectPtr Device_AddDevice        (DaqObjectPtr device, const char* connectionString);
@@ -46,17 +82,115 @@ EXPORTFUN int          Device_RemoveFunctionBlock(DaqObjectPtr device, uint64 in
 
 EXPORTFUN const char*  Device_GetAvailableDeviceConnectionString(DaqObjectPtr device, uint64 index);
 EXPORTFUN const char*  Device_GetAvailableFunctionBlockID(DaqObjectPtr device, uint64 index);
+EXPORTFUN int          Device_GetAvailableDeviceConnectionStringToBuffer(DaqObjectPtr device, uint64 index, char* buf, uint64 cap, uint64* needed);
+EXPORTFUN int          Device_GetAvailableFunctionBlockIDToBuffer(DaqObjectPtr device, uint64 index, char* buf, uint64 cap, uint64* needed);
 
 EXPORTFUN int          Device_LoadConfiguration(DaqObjectPtr device, const char* json);
 EXPORTFUN int          Device_LoadConfigurationFromFile(DaqObjectPtr device, const char* json_path);
 
 EXPORTFUN const char*  Device_SaveConfiguration(DaqObjectPtr device);
+EXPORTFUN int          Device_SaveConfigurationToBuffer(DaqObjectPtr device, char* buf, uint64 cap, uint64* needed);
 EXPORTFUN int          Device_SaveConfigurationToFile(DaqObjectPtr device, const char* json_path);
 
+// Device subtree (IDs, names, sample types, rates, property values) as one compact JSON
+// document, see SnapshotFlags in AbiTypes.h. Follows the *_ToBuffer convention; every
+// call walks the tree, so pass a generous buffer instead of querying the size first
+EXPORTFUN int          Device_Snapshot(DaqObjectPtr device, unsigned int flags, char* buf, uint64 cap, uint64* needed);
+
 EXPORTFUN int          InputPort_Connect(DaqObjectPtr port, const char* signalid, DaqObjectPtr instance);
+// Connects ports[i] to signalids[i]. All IDs are looked up in one pass over the instance;
+// every port is attempted and the first error is returned
+EXPORTFUN int          InputPort_ConnectMany(DaqObjectPtr* ports, const char** signalids, uint64 count, DaqObjectPtr instance);
 EXPORTFUN int          InputPort_Disconnect(DaqObjectPtr port);
 
 EXPORTFUN int          Signal_Read(DaqObjectPtr signal, uint64 NumOfSamples, int timeout);
+// Reads up to count samples straight into caller memory; timestamps may be NULL.
+// Returns the number of samples read. Shares its reader with Signal_Read
+EXPORTFUN int          Signal_ReadInto(DaqObjectPtr signal, double* values, int64* timestamps, uint64 count, int timeout);
+
+// Typed reads. sampleType is one of SampleTypes in AbiTypes.h; SAMPLE_TYPE_NATIVE picks the
+// signal's own type. Raw mode skips post scaling, Signal_GetScaling returns its coefficients.
+// Returns the resolved sample type. A signal has one reader: switching between typed and
+// double reads recreates it and drops the samples queued so far
+EXPORTFUN int          Signal_SetReadFormat(DaqObjectPtr signal, int sampleType, int raw);
+EXPORTFUN int          Signal_ReadTypedInto(DaqObjectPtr signal, void* values, int64* timestamps, uint64 count, int timeout);
+// Min/max envelope for plotting: reads count samples and reduces them to bins of
+// ceil(count / bins) samples each. first, last and binTimes (time of a bin's first sample)
+// may be NULL. Returns the bins written, fewer than bins when fewer samples arrived.
+// Shares its reader with Signal_Read
+EXPORTFUN int          Signal_ReadEnvelope(DaqObjectPtr signal, uint64 count, uint64 bins, double* min, double* max,
+                                           double* first, double* last, int64* binTimes, int timeout);
+// Reads up to count samples and returns only their BlockStats (AbiTypes.h).
+// Returns the number of samples read. Shares its reader with Signal_Read
+EXPORTFUN int          Signal_ReadStats(DaqObjectPtr signal, uint64 count, int timeout, BlockStats* stats);
+// EC_NOT_AVAILABLE (and 1, 0) without post scaling
+EXPORTFUN int          Signal_GetScaling(DaqObjectPtr signal, double* scale, double* offset);
+
+// Tick reads skip the per-sample time conversion: ticks receives the raw domain values
+// (may be NULL), Signal_GetDomainInfo describes them once and Signal_TicksToTime converts
+// only the ones needed, in place if ticks == times. Shares its reader with Signal_Read, so
+// tick and time reads can alternate without losing samples
+EXPORTFUN int          Signal_ReadTicksInto(DaqObjectPtr signal, double* values, int64* ticks, uint64 count, int timeout);
+EXPORTFUN int          Signal_GetDomainInfo(DaqObjectPtr signal, TickDomain* info);
+EXPORTFUN int          Signal_TicksToTime(DaqObjectPtr signal, const int64* ticks, int64* times, uint64 count);
+
+// Reads values with a linear-rule domain and returns their time axis as axis->t0 + i * axis->dt
+// instead of a timestamp per sample. Every sample the spacing breaks at is listed in breaks
+// (index, time); axis->discontinuities counts all of them, even past maxBreaks. t0 and break
+// times are in the units of Signal_GetSampleTimeStamps. EC_NOT_AVAILABLE for other domains.
+// Shares its reader with Signal_Read; the domain is checked first, a failed call reads nothing
+EXPORTFUN int          Signal_ReadLinear(DaqObjectPtr signal, double* values, uint64 count, int timeout,
+                                         TimeAxis* axis, TimeBreak* breaks, uint64 maxBreaks);
+
+// Background acquisition. A library thread drains a reader of its own into a ring of
+// ringCapacity samples (1 to 2^28, rounded up to a power of two, EC_ARRAY_OUT_OF_BOUNDS
+// otherwise); Signal_Drain copies out what has arrived and never blocks. When the ring is
+// full new samples are dropped and counted as overruns. Acquisition also stops when the
+// last handle to the signal is freed
+EXPORTFUN int          Signal_StartAcquisition(DaqObjectPtr signal, uint64 ringCapacity);
+EXPORTFUN int          Signal_StopAcquisition(DaqObjectPtr signal);
+EXPORTFUN int          Signal_Drain(DaqObjectPtr signal, double* values, int64* timestamps, uint64 max);
+EXPORTFUN int          Signal_GetAcquisitionStats(DaqObjectPtr signal, uint64* available, uint64* highWater, uint64* overruns);
+
+// Timeout mode of the reader used by Signal_Read/ReadInto/ReadTypedInto, see ReadTimeoutModes
+// in AbiTypes.h. Switching between ALL and ANY recreates the reader and drops queued samples;
+// NONE returns what is queued right away whatever timeout a read passes
+EXPORTFUN int          Signal_SetReadTimeoutMode(DaqObjectPtr signal, int mode);
+// Samples queued in that reader; creates it, so samples are kept from the first call on
+EXPORTFUN int          Signal_GetAvailableCount(DaqObjectPtr signal, uint64* count);
+
+// Status of the signal's last read (any Signal_Read* function) and the events its reads ran
+// into since the previous call, see ReadInfo in AbiTypes.h. A read stops at an event and
+// returns what it had; descriptor changes are handled inside, the next read goes on. Readers
+// that cannot convert a new descriptor are rebuilt without losing the queued samples
+EXPORTFUN int          Signal_GetReadInfo(DaqObjectPtr signal, ReadInfo* info);
+
+// Vector samples of signals whose descriptor has dimensions (spectra and the like). elements
+// receives the values per sample; labels, when not NULL, the bin axis of a one-dimensional
+// descriptor (cap entries at least). Returns EC_NOT_AVAILABLE for scalar signals
+EXPORTFUN int          Signal_GetDimensions(DaqObjectPtr signal, uint64* elements, double* labels, uint64 cap);
+// Reads up to count vector samples into values as [count x elements], timestamps may be NULL.
+// Returns the samples read; a read stops at a change of the vector length
+EXPORTFUN int          Signal_ReadVectors(DaqObjectPtr signal, double* values, int64* timestamps, uint64 count, int timeout);
+
+// Packed record layout of a struct signal (no padding, fields in descriptor order), the same
+// as the packet memory, so a #pragma pack(1) C struct of these fields maps a record directly.
+// count and recordSize are always set; fields, when not NULL, needs cap entries at least.
+// EC_NOT_AVAILABLE for other signals, EC_METHOD_NOT_IMPLEMENTED for strings or struct arrays
+EXPORTFUN int          Signal_GetStructLayout(DaqObjectPtr signal, StructField* fields, uint64 cap, uint64* count, uint64* recordSize);
+// Copies up to count struct samples into records, recordSize bytes each, timestamps may be NULL.
+// Returns the samples read; a read stops at a change of the layout
+EXPORTFUN int          Signal_ReadStructs(DaqObjectPtr signal, void* records, int64* timestamps, uint64 count, int timeout);
+// Same as Signal_ReadStructs without the copy: records points at up to count samples in the
+// packet memory, never more than one packet holds. The memory stays valid until the next
+// Signal_BorrowStructs or Signal_ReleaseStructs on the signal, or until the signal is freed
+EXPORTFUN int          Signal_BorrowStructs(DaqObjectPtr signal, const void** records, int64* timestamps, uint64 count, int timeout);
+EXPORTFUN int          Signal_ReleaseStructs(DaqObjectPtr signal);
+
+// Calls fn whenever a packet arrives and at least minSamples are queued in the reader used by
+// Signal_Read/ReadInto/ReadTypedInto, so a consumer can wait for a full block instead of
+// polling. It keeps firing while the samples stay unread. fn = NULL removes the callback
+EXPORTFUN int          Signal_SetDataCallback(DaqObjectPtr signal, DataCallback fn, void* user, uint64 minSamples);
 
 EXPORTFUN double*      Signal_GetSampleReadings(DaqObjectPtr signal);
 EXPORTFUN int64*       Signal_GetSampleTimeStamps(DaqObjectPtr signal);
@@ -77,12 +211,58 @@ EXPORTFUN int          Signal_LoadDataDescriptorFromJsonFile(DaqObjectPtr signal
 EXPORTFUN int          MultiReader_ReadToArrays(
     int64 multiReaderId, uint64 NumOfSamples, int timeout,
     double** data, int64** timestamps);
+// MultiReader_ReadToArrays into one caller buffer (a LabVIEW 2D array) in a BufferLayouts
+// layout. stride is the row pitch in elements, 0 for a dense block: interleaved rows need
+// NumOfSignals at least, planar rows NumOfSamples. timestamps, when not NULL, are laid out
+// the same way. Padding elements of a row are left alone
+EXPORTFUN int          MultiReader_ReadToBuffer(
+    int64 multiReaderId, uint64 NumOfSamples, int timeout,
+    int layout, uint64 stride, double* data, int64* timestamps);
+// MultiReader_ReadToArrays with a single timestamp column of NumOfSamples for the group, the
+// reader aligns the signals on a common domain. Only the first signal's domain is copied and
+// converted, once. MultiReader_ReadLinear returns (t0, dt) instead
+EXPORTFUN int          MultiReader_ReadShared(
+    int64 multiReaderId, uint64 NumOfSamples, int timeout,
+    double** data, int64* timestamps);
+// Signal_ReadEnvelope for every bound signal; the signals are aligned, so binTimes is one
+// array shared by all of them
+EXPORTFUN int          MultiReader_ReadEnvelope(
+    int64 multiReaderId, uint64 NumOfSamples, uint64 bins, int timeout,
+    double** min, double** max, double** first, double** last, int64* binTimes);
+// Signal_ReadStats for every bound signal, stats holds one BlockStats per signal.
+// Blocks of more than a few 10k samples in total are reduced on several threads
+EXPORTFUN int          MultiReader_ReadStats(int64 multiReaderId, uint64 NumOfSamples, int timeout, BlockStats* stats);
+// MultiReader_ReadToArrays with one time axis for the group, see Signal_ReadLinear
+EXPORTFUN int          MultiReader_ReadLinear(
+    int64 multiReaderId, uint64 NumOfSamples, int timeout,
+    double** data, TimeAxis* axis, TimeBreak* breaks, uint64 maxBreaks);
 
+// Returns a positive ID or a negative error code. IDs stay valid until their own UnBind, an
+// unbound ID is rejected with EC_ARRAY_OUT_OF_BOUNDS even after its slot is reused
 EXPORTFUN int64        MultiReader_Bind(DaqObjectPtrArray signals, uint64 NumOfSignals);
+// MultiReader_ReadToArrays of a reader bound this way returns raw domain ticks, described by
+// Signal_GetDomainInfo of the first signal
+EXPORTFUN int64        MultiReader_BindTicks(DaqObjectPtrArray signals, uint64 NumOfSignals);
 EXPORTFUN int          MultiReader_UnBind(int64 multiReaderId);
+// Same as the Signal_ functions; the available count is the minimum over the bound signals
+EXPORTFUN int          MultiReader_SetReadTimeoutMode(int64 multiReaderId, int mode);
+EXPORTFUN int          MultiReader_GetAvailableCount(int64 multiReaderId, uint64* count);
+EXPORTFUN int          MultiReader_GetReadInfo(int64 multiReaderId, ReadInfo* info);
+// Same as Signal_SetDataCallback; minSamples have to be available on every bound signal
+EXPORTFUN int          MultiReader_SetDataCallback(int64 multiReaderId, DataCallback fn, void* user, uint64 minSamples);
+
+// Signal_SetReadFormat for the group: every signal is read as one type, SAMPLE_TYPE_NATIVE
+// picks the first signal's. Recreates the reader like Signal_SetReadFormat. The double reads
+// (ReadToArrays, ReadToBuffer, ReadShared, Linear, Envelope, Stats) need Float64 and return
+// EC_OBJECT_TYPE_MISMATCH for other types, MultiReader_ReadTypedToArrays takes any
+EXPORTFUN int          MultiReader_SetReadFormat(int64 multiReaderId, int sampleType, int raw);
+EXPORTFUN int          MultiReader_ReadTypedToArrays(
+    int64 multiReaderId, uint64 NumOfSamples, int timeout,
+    void** data, int64** timestamps);
 
 EXPORTFUN const char*  DataDescriptor_SaveToJson(DaqObjectPtr signal);
 EXPORTFUN int          DataDescriptor_SaveToJsonFile(DaqObjectPtr signal, const char* path);
+EXPORTFUN int          DataDescriptor_SaveToJsonToBuffer(DaqObjectPtr signal, char* buf, uint64 cap, uint64* needed);
 
 EXPORTFUN const char*  TimeStampToString(int64 timestamp);
 